@@ -1,40 +1,20 @@
 #include <array>
+#include <filesystem>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 #include <libbase64.h>
 #include <turbob64.h>
 
-inline void initializeAklompBase64()
-{
-    size_t outlen = 0;
-    base64_encode(nullptr, 0, nullptr, &outlen, 0);
-}
-
-class Initializer
-{
-public:
-    Initializer()
-    {
-        // Initialize Turbo-Base64
-        tb64ini(0, 0);
-        // Initialize Aklomp Base64
-        initializeAklompBase64();
-    }
-
-    static const std::array<std::string_view, 15> stringsToEncode;
-    static const std::array<std::string_view, 15> stringsToDecode;
-
-private:
-    static const std::string_view longestSearchPhrase;
-    static const std::string_view longestSearchPhraseBase64;
-
-    static const std::string_view longestURL;
-    static const std::string_view longestURLBase64;
-
-    static const std::string_view longestTitle;
-    static const std::string_view longestTitleBase64;
-};
+#include "codecs.h"
+#include "fingerprint.h"
+#include "initializer.h"
+#include "perf_counters.h"
+#include "results.h"
 
 Initializer g;
 
@@ -46,6 +26,7 @@ static void BM_TurboBase64Encode(benchmark::State & state)
     state.counters["size"] = static_cast<double>(size);
     std::string output;
     output.resize(static_cast<std::size_t>(static_cast<long double>(size) * 1.5));
+    PerfCounters perf_counters;
     for ([[maybe_unused]] auto iteration : state)
     {
 #if defined(__aarch64__)
@@ -56,6 +37,7 @@ static void BM_TurboBase64Encode(benchmark::State & state)
         benchmark::DoNotOptimize(output);
     }
     state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
 }
 
 static void BM_TurboBase64Decode(benchmark::State & state)
@@ -66,6 +48,7 @@ static void BM_TurboBase64Decode(benchmark::State & state)
     state.counters["size"] = static_cast<double>(size);
     std::string output;
     output.resize(size);
+    PerfCounters perf_counters;
     for ([[maybe_unused]] auto iteration : state)
     {
 #if defined(__aarch64__)
@@ -76,6 +59,7 @@ static void BM_TurboBase64Decode(benchmark::State & state)
         benchmark::DoNotOptimize(output);
     }
     state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
 }
 
 static void BM_AklompBase64Encode(benchmark::State & state)
@@ -87,12 +71,14 @@ static void BM_AklompBase64Encode(benchmark::State & state)
     std::string output;
     output.resize(static_cast<std::size_t>(static_cast<long double>(size) * 1.5));
     std::size_t outlen = 0;
+    PerfCounters perf_counters;
     for ([[maybe_unused]] auto iteration : state)
     {
         base64_encode(input.data(), size, output.data(), &outlen, 0);
         benchmark::DoNotOptimize(output);
     }
     state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
 }
 
 static void BM_AklompBase64Decode(benchmark::State & state)
@@ -104,36 +90,136 @@ static void BM_AklompBase64Decode(benchmark::State & state)
     std::string output;
     output.resize(size);
     std::size_t outlen = 0;
+    PerfCounters perf_counters;
     for ([[maybe_unused]] auto iteration : state)
     {
         base64_decode(input.data(), size, output.data(), &outlen, 0);
         benchmark::DoNotOptimize(output);
     }
     state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
+}
+
+static void BM_Avx512VbmiBase64Encode(benchmark::State & state)
+{
+    const auto idx = state.range(0);
+    const auto input = Initializer::stringsToEncode[idx];
+    const auto size = input.size();
+    state.counters["size"] = static_cast<double>(size);
+    if (!hasAvx512Vbmi())
+        state.SetLabel("scalar fallback");
+    std::string output;
+    output.resize(static_cast<std::size_t>(static_cast<long double>(size) * 1.5));
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        Avx512VbmiBase64::encode(input.data(), size, output.data());
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
+}
+
+static void BM_Avx512VbmiBase64Decode(benchmark::State & state)
+{
+    const auto idx = state.range(0);
+    const auto input = Initializer::stringsToDecode[idx];
+    const auto size = input.size();
+    state.counters["size"] = static_cast<double>(size);
+    if (!hasAvx512Vbmi())
+        state.SetLabel("scalar fallback");
+    std::string output;
+    output.resize(size);
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        Avx512VbmiBase64::decode(input.data(), size, output.data());
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
+}
+
+static void BM_Avx512VbmiShortBase64Encode(benchmark::State & state)
+{
+    const auto idx = state.range(0);
+    const auto input = Initializer::stringsToEncode[idx];
+    const auto size = input.size();
+    state.counters["size"] = static_cast<double>(size);
+    if (!hasAvx512Vbmi())
+        state.SetLabel("scalar fallback");
+    else if (size > avx512ShortEncodeLimit)
+        state.SetLabel("full kernel fallback");
+    std::string output;
+    output.resize(static_cast<std::size_t>(static_cast<long double>(size) * 1.5));
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        Avx512VbmiShortBase64::encode(input.data(), size, output.data());
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
+}
+
+static void BM_Avx512VbmiShortBase64Decode(benchmark::State & state)
+{
+    const auto idx = state.range(0);
+    const auto input = Initializer::stringsToDecode[idx];
+    const auto size = input.size();
+    state.counters["size"] = static_cast<double>(size);
+    if (!hasAvx512Vbmi())
+        state.SetLabel("scalar fallback");
+    else if (size > avx512ShortDecodeLimit)
+        state.SetLabel("full kernel fallback");
+    std::string output;
+    output.resize(size);
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        Avx512VbmiShortBase64::decode(input.data(), size, output.data());
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
 }
 
 
 BENCHMARK(BM_TurboBase64Encode)->DenseRange(0, 2)->Name("Turbo-Base64 encode ~50 symbols");
 BENCHMARK(BM_AklompBase64Encode)->DenseRange(0, 2)->Name("aklomp/base64 encode ~50 symbols");
+BENCHMARK(BM_Avx512VbmiBase64Encode)->DenseRange(0, 2)->Name("AVX-512 VBMI encode ~50 symbols");
+BENCHMARK(BM_Avx512VbmiShortBase64Encode)->DenseRange(0, 2)->Name("AVX-512 VBMI short encode ~50 symbols");
 BENCHMARK(BM_TurboBase64Encode)->DenseRange(3, 5)->Name("Turbo-Base64 encode ~100 symbols");
 BENCHMARK(BM_AklompBase64Encode)->DenseRange(3, 5)->Name("aklomp/base64 encode ~100 symbols");
+BENCHMARK(BM_Avx512VbmiBase64Encode)->DenseRange(3, 5)->Name("AVX-512 VBMI encode ~100 symbols");
+BENCHMARK(BM_Avx512VbmiShortBase64Encode)->DenseRange(3, 5)->Name("AVX-512 VBMI short encode ~100 symbols");
 BENCHMARK(BM_TurboBase64Encode)->DenseRange(6, 8)->Name("Turbo-Base64 encode ~200 symbols");
 BENCHMARK(BM_AklompBase64Encode)->DenseRange(6, 8)->Name("aklomp/base64 encode ~200 symbols");
+BENCHMARK(BM_Avx512VbmiBase64Encode)->DenseRange(6, 8)->Name("AVX-512 VBMI encode ~200 symbols");
 BENCHMARK(BM_TurboBase64Encode)->DenseRange(9, 11)->Name("Turbo-Base64 encode ~500 symbols");
 BENCHMARK(BM_AklompBase64Encode)->DenseRange(9, 11)->Name("aklomp/base64 encode ~500 symbols");
+BENCHMARK(BM_Avx512VbmiBase64Encode)->DenseRange(9, 11)->Name("AVX-512 VBMI encode ~500 symbols");
 BENCHMARK(BM_TurboBase64Encode)->DenseRange(12, 14)->Name("Turbo-Base64 encode longest in ClickBench");
 BENCHMARK(BM_AklompBase64Encode)->DenseRange(12, 14)->Name("aklomp/base64 encode longest in ClickBench");
+BENCHMARK(BM_Avx512VbmiBase64Encode)->DenseRange(12, 14)->Name("AVX-512 VBMI encode longest in ClickBench");
 
 BENCHMARK(BM_TurboBase64Decode)->DenseRange(0, 2)->Name("Turbo-Base64 decode ~50 symbols");
 BENCHMARK(BM_AklompBase64Decode)->DenseRange(0, 2)->Name("aklomp/base64 decode ~50 symbols");
+BENCHMARK(BM_Avx512VbmiBase64Decode)->DenseRange(0, 2)->Name("AVX-512 VBMI decode ~50 symbols");
+BENCHMARK(BM_Avx512VbmiShortBase64Decode)->DenseRange(0, 2)->Name("AVX-512 VBMI short decode ~50 symbols");
 BENCHMARK(BM_TurboBase64Decode)->DenseRange(3, 5)->Name("Turbo-Base64 decode ~100 symbols");
 BENCHMARK(BM_AklompBase64Decode)->DenseRange(3, 5)->Name("aklomp/base64 decode ~100 symbols");
+BENCHMARK(BM_Avx512VbmiBase64Decode)->DenseRange(3, 5)->Name("AVX-512 VBMI decode ~100 symbols");
+BENCHMARK(BM_Avx512VbmiShortBase64Decode)->DenseRange(3, 5)->Name("AVX-512 VBMI short decode ~100 symbols");
 BENCHMARK(BM_TurboBase64Decode)->DenseRange(6, 8)->Name("Turbo-Base64 decode ~200 symbols");
 BENCHMARK(BM_AklompBase64Decode)->DenseRange(6, 8)->Name("aklomp/base64 decode ~200 symbols");
+BENCHMARK(BM_Avx512VbmiBase64Decode)->DenseRange(6, 8)->Name("AVX-512 VBMI decode ~200 symbols");
 BENCHMARK(BM_TurboBase64Decode)->DenseRange(9, 11)->Name("Turbo-Base64 decode ~500 symbols");
 BENCHMARK(BM_AklompBase64Decode)->DenseRange(9, 11)->Name("aklomp/base64 decode ~500 symbols");
+BENCHMARK(BM_Avx512VbmiBase64Decode)->DenseRange(9, 11)->Name("AVX-512 VBMI decode ~500 symbols");
 BENCHMARK(BM_TurboBase64Decode)->DenseRange(12, 14)->Name("Turbo-Base64 decode longest in ClickBench");
 BENCHMARK(BM_AklompBase64Decode)->DenseRange(12, 14)->Name("aklomp/base64 decode longest in ClickBench");
+BENCHMARK(BM_Avx512VbmiBase64Decode)->DenseRange(12, 14)->Name("AVX-512 VBMI decode longest in ClickBench");
 
 // clang-format off
 
@@ -457,4 +543,55 @@ const std::string_view Initializer::longestTitleBase64 =
     "sNGF0Lgg0Lgg0Lgg0LTRgNGD0LPQuNGFINCz0LvQsNC80YMg0J3QvtCy0LPQvtGA0L7QtCAtINCv0L3QtNC10LrRgS7Qn9C+0LPQvtC00LAg0LTQu9GPINC00LXRgtC10Lkg0L"
     "Ig0KDRj9C30LDQvdGB0LopIHwg0J/RgNC+0LTQsNC20LAg0LDQstGC0L7RgdCw0LvQvtC90YssINC/0YDQviDQv9Cw0YDRgtCw0YU=";
 
-BENCHMARK_MAIN();
+/// The usual main of Google Benchmark with two additions: the machine fingerprint goes into the context of the run,
+/// and `--results_store=DIR` writes the run to a new JSON file in DIR, see results.h.
+int main(int argc, char ** argv)
+{
+    std::vector<char *> args(argv, argv + argc);
+    std::string results_path;
+    std::string out_argument;
+    std::string format_argument = "--benchmark_out_format=json";
+    for (auto it = args.begin(); it != args.end(); ++it)
+    {
+        const std::string_view arg = *it;
+        if (!arg.starts_with("--results_store="))
+            continue;
+        try
+        {
+            results_path = newResultsPath(std::string(arg.substr(std::string_view("--results_store=").size())));
+        }
+        catch (const std::runtime_error & e)
+        {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        out_argument = "--benchmark_out=" + results_path;
+        args.erase(it);
+        args.push_back(out_argument.data());
+        args.push_back(format_argument.data());
+        break;
+    }
+    auto args_count = static_cast<int>(args.size());
+    args.push_back(nullptr);
+
+    // The file reserved in the store is removed when nothing is written to it.
+    const auto remove_results = [&]
+    {
+        std::error_code error;
+        if (!results_path.empty())
+            std::filesystem::remove(results_path, error);
+    };
+
+    benchmark::Initialize(&args_count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(args_count, args.data()))
+    {
+        remove_results();
+        return 1;
+    }
+    for (const auto & [key, value] : machineFingerprint())
+        benchmark::AddCustomContext(key, value);
+    if (benchmark::RunSpecifiedBenchmarks() == 0)
+        remove_results();
+    benchmark::Shutdown();
+    return 0;
+}
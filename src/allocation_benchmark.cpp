@@ -0,0 +1,242 @@
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "arena.h"
+#include "codecs.h"
+#include "initializer.h"
+#include "perf_counters.h"
+
+/// Encoding and decoding with the cost of allocating the output: every iteration is a batch of `rows` calls
+/// on the ~50, ~100 and ~200 symbols inputs, and the outputs of a batch are kept until its end, as the responses
+/// of a request would be. The output is a `std::string` per call, a `std::pmr::string` from a monotonic buffer
+/// resource over a buffer of the size of a batch, released per batch, or memory of the thread's arena (see arena.h),
+/// which is reset per batch. `retained_memory` is what the output keeps between batches, it must not grow
+/// after the first batch.
+static constexpr size_t allocationInputs = 9;
+
+struct StringPerCall
+{
+    static constexpr const char * name = "std::string per call";
+
+    explicit StringPerCall(size_t rows) { results.reserve(rows); }
+
+    void beginBatch() { results.clear(); }
+
+    size_t retainedMemory() const { return 0; }
+
+    template <typename Codec>
+    std::string_view encode(std::string_view input)
+    {
+        auto & result = results.emplace_back();
+        result.resize(base64EncodedSize(input.size()));
+        result.resize(Codec::encode(input.data(), input.size(), result.data()));
+        return result;
+    }
+
+    template <typename Codec>
+    bool decode(std::string_view input, std::string_view & output)
+    {
+        auto & result = results.emplace_back();
+        result.resize(base64DecodedSizeUpperBound(input.size()));
+        result.resize(Codec::decode(input.data(), input.size(), result.data()));
+        output = result;
+        return !result.empty();
+    }
+
+    std::vector<std::string> results;
+};
+
+struct PmrMonotonic
+{
+    static constexpr const char * name = "pmr monotonic";
+
+    /// More than the output of any of the inputs with the overhead of its allocation.
+    static constexpr size_t bytesPerRow = 512;
+
+    explicit PmrMonotonic(size_t rows)
+        : buffer(rows * bytesPerRow)
+        , resource(buffer.data(), buffer.size())
+    {
+        results.reserve(rows);
+    }
+
+    /// `release` goes back to the initial buffer, which holds a whole batch, so the resource does not allocate.
+    void beginBatch()
+    {
+        results.clear();
+        resource.release();
+    }
+
+    size_t retainedMemory() const { return buffer.size(); }
+
+    template <typename Codec>
+    std::string_view encode(std::string_view input)
+    {
+        auto & result = results.emplace_back(&resource);
+        result.resize(base64EncodedSize(input.size()));
+        result.resize(Codec::encode(input.data(), input.size(), result.data()));
+        return result;
+    }
+
+    template <typename Codec>
+    bool decode(std::string_view input, std::string_view & output)
+    {
+        auto & result = results.emplace_back(&resource);
+        result.resize(base64DecodedSizeUpperBound(input.size()));
+        result.resize(Codec::decode(input.data(), input.size(), result.data()));
+        output = result;
+        return !result.empty();
+    }
+
+    /// Declared in the order of use, so that the strings are destroyed before their resource and its buffer.
+    std::vector<char> buffer;
+    std::pmr::monotonic_buffer_resource resource;
+    std::vector<std::pmr::string> results;
+};
+
+struct ThreadArena
+{
+    static constexpr const char * name = "arena";
+
+    explicit ThreadArena(size_t) { }
+
+    void beginBatch() { threadArena().reset(); }
+
+    size_t retainedMemory() const { return threadArena().capacity(); }
+
+    template <typename Codec>
+    std::string_view encode(std::string_view input)
+    {
+        return arenaEncode<Codec>(threadArena(), input);
+    }
+
+    template <typename Codec>
+    bool decode(std::string_view input, std::string_view & output)
+    {
+        return arenaDecode<Codec>(threadArena(), input, output);
+    }
+};
+
+static void setAllocationCounters(benchmark::State & state, const std::array<std::string_view, 15> & inputs, size_t rows)
+{
+    size_t bytes = 0;
+    for (size_t row = 0; row < rows; ++row)
+        bytes += inputs[row % allocationInputs].size();
+    state.counters["rows_per_second"]
+        = benchmark::Counter(static_cast<double>(rows) * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+
+template <typename Codec, typename Output>
+static void BM_EncodeAllocating(benchmark::State & state)
+{
+    const auto rows = static_cast<size_t>(state.range(0));
+    const auto & inputs = Initializer::stringsToEncode;
+    Output output(rows);
+    std::vector<std::string_view> results(rows);
+
+    output.beginBatch();
+    for (size_t row = 0; row < rows; ++row)
+    {
+        const auto input = inputs[row % allocationInputs];
+        std::string expected(base64EncodedSize(input.size()), '\0');
+        Codec::encode(input.data(), input.size(), expected.data());
+        if (output.template encode<Codec>(input) != expected)
+        {
+            state.SkipWithError("The encoded output differs from the codec");
+            return;
+        }
+    }
+
+    const auto retained_memory = output.retainedMemory();
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        output.beginBatch();
+        for (size_t row = 0; row < rows; ++row)
+            results[row] = output.template encode<Codec>(inputs[row % allocationInputs]);
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+    if (output.retainedMemory() != retained_memory)
+    {
+        state.SkipWithError("The output memory grew after the first batch");
+        return;
+    }
+    state.counters["retained_memory"] = benchmark::Counter(static_cast<double>(retained_memory), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+    setAllocationCounters(state, inputs, rows);
+    perf_counters.report(state);
+}
+
+template <typename Codec, typename Output>
+static void BM_DecodeAllocating(benchmark::State & state)
+{
+    const auto rows = static_cast<size_t>(state.range(0));
+    const auto & inputs = Initializer::stringsToDecode;
+    Output output(rows);
+    std::vector<std::string_view> results(rows);
+
+    output.beginBatch();
+    for (size_t row = 0; row < rows; ++row)
+    {
+        std::string_view decoded;
+        if (!output.template decode<Codec>(inputs[row % allocationInputs], decoded)
+            || decoded != Initializer::stringsToEncode[row % allocationInputs])
+        {
+            state.SkipWithError("The decoded output differs from the original data");
+            return;
+        }
+    }
+
+    const auto retained_memory = output.retainedMemory();
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        output.beginBatch();
+        for (size_t row = 0; row < rows; ++row)
+            output.template decode<Codec>(inputs[row % allocationInputs], results[row]);
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+    if (output.retainedMemory() != retained_memory)
+    {
+        state.SkipWithError("The output memory grew after the first batch");
+        return;
+    }
+    state.counters["retained_memory"] = benchmark::Counter(static_cast<double>(retained_memory), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+    setAllocationCounters(state, inputs, rows);
+    perf_counters.report(state);
+}
+
+template <typename Codec, typename Output>
+static void registerAllocationBenchmarks()
+{
+    const auto suffix = std::string(" ") + Output::name;
+    benchmark::RegisterBenchmark((std::string(Codec::name) + " encode" + suffix).c_str(), BM_EncodeAllocating<Codec, Output>)
+        ->ArgName("rows")
+        ->Arg(16)
+        ->Arg(1024)
+        ->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark((std::string(Codec::name) + " decode" + suffix).c_str(), BM_DecodeAllocating<Codec, Output>)
+        ->ArgName("rows")
+        ->Arg(16)
+        ->Arg(1024)
+        ->Unit(benchmark::kMicrosecond);
+}
+
+static bool registerAllAllocationBenchmarks()
+{
+    registerAllocationBenchmarks<TurboBase64, StringPerCall>();
+    registerAllocationBenchmarks<TurboBase64, PmrMonotonic>();
+    registerAllocationBenchmarks<TurboBase64, ThreadArena>();
+    registerAllocationBenchmarks<AklompBase64, StringPerCall>();
+    registerAllocationBenchmarks<AklompBase64, PmrMonotonic>();
+    registerAllocationBenchmarks<AklompBase64, ThreadArena>();
+    return true;
+}
+
+[[maybe_unused]] static const bool allocationBenchmarksRegistered = registerAllAllocationBenchmarks();
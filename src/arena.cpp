@@ -0,0 +1,36 @@
+#include "arena.h"
+
+#include <algorithm>
+
+size_t Arena::capacity() const
+{
+    size_t result = 0;
+    for (const auto & chunk : chunks)
+        result += chunk.size;
+    return result;
+}
+
+char * Arena::allocSlow(size_t size)
+{
+    // After a reset, the chunks are reused in order, the ones that are too small for this allocation are skipped.
+    if (current < chunks.size())
+        ++current;
+    while (current < chunks.size() && chunks[current].size < size)
+        ++current;
+
+    if (current == chunks.size())
+    {
+        const auto chunk_size = std::max(next_chunk_size, size);
+        next_chunk_size = chunk_size * 2;
+        chunks.push_back({std::make_unique_for_overwrite<char[]>(chunk_size), chunk_size});
+    }
+
+    position = size;
+    return chunks[current].data.get();
+}
+
+Arena & threadArena()
+{
+    thread_local Arena arena;
+    return arena;
+}
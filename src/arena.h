@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "codecs.h"
+
+/// A bump allocator for the outputs of a batch of calls: memory is taken from the current chunk in order
+/// and released all at once by `reset`, which keeps the chunks, so that a steady stream of batches does not
+/// call malloc at all once the arena has grown to the size of a batch.
+class Arena
+{
+public:
+    explicit Arena(size_t first_chunk_size = 64 << 10) : next_chunk_size(first_chunk_size) { }
+
+    Arena(const Arena &) = delete;
+    Arena & operator=(const Arena &) = delete;
+
+    /// Uninitialized memory for `size` bytes, valid until `reset`. Not aligned.
+    char * alloc(size_t size)
+    {
+        if (current < chunks.size() && size <= chunks[current].size - position)
+        {
+            char * result = chunks[current].data.get() + position;
+            position += size;
+            return result;
+        }
+        return allocSlow(size);
+    }
+
+    /// Makes all the memory available again, the results of previous `alloc` calls become invalid.
+    void reset()
+    {
+        current = 0;
+        position = 0;
+    }
+
+    /// Total size of the chunks.
+    size_t capacity() const;
+
+private:
+    struct Chunk
+    {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    char * allocSlow(size_t size);
+
+    std::vector<Chunk> chunks;
+    size_t current = 0;
+    size_t position = 0;
+    size_t next_chunk_size;
+};
+
+/// The arena of the calling thread.
+Arena & threadArena();
+
+/// Encodes `input` into memory of `arena`, the result is valid until `arena.reset()`.
+template <typename Codec>
+std::string_view arenaEncode(Arena & arena, std::string_view input)
+{
+    char * out = arena.alloc(base64EncodedSize(input.size()));
+    return {out, Codec::encode(input.data(), input.size(), out)};
+}
+
+/// Decodes `input` into memory of `arena`, `output` is valid until `arena.reset()`.
+/// Returns false if `input` is not valid base64.
+template <typename Codec>
+bool arenaDecode(Arena & arena, std::string_view input, std::string_view & output)
+{
+    char * out = arena.alloc(base64DecodedSizeUpperBound(input.size()));
+    const auto written = Codec::decode(input.data(), input.size(), out);
+    if (written == 0 && !input.empty())
+        return false;
+    output = {out, written};
+    return true;
+}
@@ -0,0 +1,448 @@
+#include "avx512_codec.h"
+
+#include "crc32c.h"
+#include "mime.h"
+#include "scalar_codec.h"
+
+#if defined(__x86_64__)
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <immintrin.h>
+
+/// The kernels are compiled for AVX-512 function by function rather than with flags for the whole file,
+/// so that `hasAvx512Vbmi` and the inline functions of the headers instantiated here stay baseline x86-64 code.
+#define AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE __attribute__((target("avx512f,avx512bw,avx512vbmi")))
+
+bool hasAvx512Vbmi()
+{
+    static const bool supported = []
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vbmi");
+    }();
+    return supported;
+}
+
+namespace
+{
+
+/// Mask of the first `size` bytes of a register, `size` is at most 64.
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE inline __mmask64 prefixMask(size_t size)
+{
+    return size >= 64 ? ~__mmask64{0} : (__mmask64{1} << size) - 1;
+}
+
+/// Raw CRC32C state (without the final inversion) updated with the low 48 bytes of `block`,
+/// taken from the register rather than reloaded from memory.
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE inline uint32_t crc32cBlock(uint32_t state, __m512i block)
+{
+    const __m128i lane0 = _mm512_castsi512_si128(block);
+    const __m128i lane1 = _mm512_extracti32x4_epi32(block, 1);
+    const __m128i lane2 = _mm512_extracti32x4_epi32(block, 2);
+    uint64_t state64 = state;
+    state64 = _mm_crc32_u64(state64, static_cast<uint64_t>(_mm_cvtsi128_si64(lane0)));
+    state64 = _mm_crc32_u64(state64, static_cast<uint64_t>(_mm_extract_epi64(lane0, 1)));
+    state64 = _mm_crc32_u64(state64, static_cast<uint64_t>(_mm_cvtsi128_si64(lane1)));
+    state64 = _mm_crc32_u64(state64, static_cast<uint64_t>(_mm_extract_epi64(lane1, 1)));
+    state64 = _mm_crc32_u64(state64, static_cast<uint64_t>(_mm_cvtsi128_si64(lane2)));
+    state64 = _mm_crc32_u64(state64, static_cast<uint64_t>(_mm_extract_epi64(lane2, 1)));
+    return static_cast<uint32_t>(state64);
+}
+
+/// 48 bytes in the low part of `input` to 64 symbols of `alphabet`.
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE inline __m512i encodeBlock(__m512i input, const char * alphabet_symbols = base64Alphabet)
+{
+    // Every 32-bit lane gets bytes [b1 b0 b2 b1] of its 3-byte group, so that the 6-bit fields
+    // can be picked with a single multishift at fixed bit offsets.
+    const __m512i shuffle_input = _mm512_setr_epi32(
+        0x01020001, 0x04050304, 0x07080607, 0x0a0b090a, 0x0d0e0c0d, 0x10110f10, 0x13141213, 0x16171516,
+        0x191a1819, 0x1c1d1b1c, 0x1f201e1f, 0x22232122, 0x25262425, 0x28292728, 0x2b2c2a2b, 0x2e2f2d2e);
+    const __m512i shifts = _mm512_set1_epi64(0x3036242a1016040a);
+    const __m512i alphabet = _mm512_loadu_si512(alphabet_symbols);
+
+    const __m512i shuffled = _mm512_permutexvar_epi8(shuffle_input, input);
+    // vpermb only looks at the low 6 bits of the indices, the garbage above them does not matter.
+    const __m512i indices = _mm512_multishift_epi64_epi8(shifts, shuffled);
+    return _mm512_permutexvar_epi8(indices, alphabet);
+}
+
+/// ASCII to 6-bit values, 0x80 for symbols that are not in the alphabet (including '=').
+alignas(64) constexpr std::array<uint8_t, 128> decodeLookup = {
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 62,   0x80, 0x80, 0x80, 63,
+    52,   53,   54,   55,   56,   57,   58,   59,   60,   61,   0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0,    1,    2,    3,    4,    5,    6,    7,    8,    9,    10,   11,   12,   13,   14,
+    15,   16,   17,   18,   19,   20,   21,   22,   23,   24,   25,   0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 26,   27,   28,   29,   30,   31,   32,   33,   34,   35,   36,   37,   38,   39,   40,
+    41,   42,   43,   44,   45,   46,   47,   48,   49,   50,   51,   0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+/// The same for base64url: '-' and '_' instead of '+' and '/'.
+alignas(64) constexpr std::array<uint8_t, 128> urlDecodeLookup = []
+{
+    auto lookup = decodeLookup;
+    lookup['+'] = 0x80;
+    lookup['/'] = 0x80;
+    lookup['-'] = 62;
+    lookup['_'] = 63;
+    return lookup;
+}();
+
+/// 64 symbols to 48 bytes in the low part of the result.
+/// Adds the positions of the symbols that are not in the alphabet of `lookup` to `invalid`.
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE inline __m512i decodeBlock(__m512i input, __mmask64 & invalid, const std::array<uint8_t, 128> & lookup = decodeLookup)
+{
+    const __m512i lookup_low = _mm512_load_si512(lookup.data());
+    const __m512i lookup_high = _mm512_load_si512(lookup.data() + 64);
+    // Pairs of 6-bit values into 12 bits, then pairs of 12-bit values into 24 bits per 32-bit lane.
+    const __m512i merge_pairs = _mm512_set1_epi32(0x01400140);
+    const __m512i merge_quads = _mm512_set1_epi32(0x00011000);
+    // The 3 significant bytes of every 32-bit lane in big-endian order.
+    const __m512i pack = _mm512_set_epi8(
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        60, 61, 62, 56, 57, 58, 52, 53, 54, 48, 49, 50, 44, 45, 46, 40,
+        41, 42, 36, 37, 38, 32, 33, 34, 28, 29, 30, 24, 25, 26, 20, 21,
+        22, 16, 17, 18, 12, 13, 14, 8, 9, 10, 4, 5, 6, 0, 1, 2);
+
+    const __m512i values = _mm512_permutex2var_epi8(lookup_low, input, lookup_high);
+    // Non-ASCII input has the high bit set itself, the rest of the invalid symbols got it from the lookup.
+    invalid |= _mm512_movepi8_mask(_mm512_or_si512(values, input));
+    const __m512i merged = _mm512_madd_epi16(_mm512_maddubs_epi16(values, merge_pairs), merge_quads);
+    return _mm512_permutexvar_epi8(pack, merged);
+}
+
+/// Encodes up to `Blocks` * 48 bytes without a scalar tail: the input is read with masked loads
+/// (the missing bytes are zeros, which gives the right partial symbols), '=' is blended in
+/// and the output is written with masked stores.
+template <size_t Blocks>
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE size_t encodeShort(const char * src, size_t srclen, char * out)
+{
+    const auto outlen = (srclen + 2) / 3 * 4;
+    const auto symbols = (srclen * 4 + 2) / 3;
+    const __m512i padding = _mm512_set1_epi8('=');
+
+    for (size_t block = 0; block < Blocks; ++block)
+    {
+        const size_t in_begin = block * 48;
+        const size_t out_begin = block * 64;
+        const auto in_size = srclen > in_begin ? srclen - in_begin : 0;
+        const auto symbols_size = symbols > out_begin ? symbols - out_begin : 0;
+        const auto out_size = outlen > out_begin ? outlen - out_begin : 0;
+
+        const __m512i input = _mm512_maskz_loadu_epi8(prefixMask(std::min<size_t>(in_size, 48)), src + in_begin);
+        const __m512i encoded = _mm512_mask_blend_epi8(prefixMask(symbols_size), padding, encodeBlock(input));
+        _mm512_mask_storeu_epi8(out + out_begin, prefixMask(out_size), encoded);
+    }
+    return outlen;
+}
+
+/// Decodes up to `Blocks` * 64 symbols without a scalar tail: the padding and the symbols past the end
+/// are replaced with 'A' by masked loads, the output is written with masked stores.
+template <size_t Blocks>
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE size_t decodeShort(const char * src, size_t srclen, char * out)
+{
+    if (srclen == 0 || srclen % 4 != 0)
+        return 0;
+
+    const size_t padding = (src[srclen - 1] == '=') + (src[srclen - 1] == '=' && src[srclen - 2] == '=');
+    const auto symbols = srclen - padding;
+    const auto outlen = srclen / 4 * 3 - padding;
+    const __m512i filler = _mm512_set1_epi8('A');
+
+    __mmask64 invalid = 0;
+    for (size_t block = 0; block < Blocks; ++block)
+    {
+        const size_t in_begin = block * 64;
+        const size_t out_begin = block * 48;
+        const auto in_size = symbols > in_begin ? symbols - in_begin : 0;
+        const auto out_size = outlen > out_begin ? outlen - out_begin : 0;
+
+        const __m512i input = _mm512_mask_loadu_epi8(filler, prefixMask(in_size), src + in_begin);
+        _mm512_mask_storeu_epi8(out + out_begin, prefixMask(std::min<size_t>(out_size, 48)), decodeBlock(input, invalid));
+    }
+    return invalid == 0 ? outlen : 0;
+}
+
+}
+
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE size_t avx512vbmiEncode(const char * src, size_t srclen, char * out)
+{
+    const __mmask64 input_mask = prefixMask(48);
+
+    size_t i = 0;
+    size_t written = 0;
+    for (; i + 48 <= srclen; i += 48, written += 64)
+        _mm512_storeu_si512(out + written, encodeBlock(_mm512_maskz_loadu_epi8(input_mask, src + i)));
+
+    return written + scalarEncode(src + i, srclen - i, out + written);
+}
+
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE size_t avx512vbmiDecode(const char * src, size_t srclen, char * out)
+{
+    if (srclen == 0 || srclen % 4 != 0)
+        return 0;
+
+    const __mmask64 output_mask = prefixMask(48);
+
+    // The last block may have padding, which the kernel treats as invalid, so it is left for the scalar codec.
+    size_t i = 0;
+    size_t written = 0;
+    for (; i + 64 < srclen; i += 64, written += 48)
+    {
+        __mmask64 invalid = 0;
+        const __m512i decoded = decodeBlock(_mm512_loadu_si512(src + i), invalid);
+        if (invalid != 0)
+            return 0;
+        _mm512_mask_storeu_epi8(out + written, output_mask, decoded);
+    }
+
+    const auto tail = scalarDecode(src + i, srclen - i, out + written);
+    if (tail == 0)
+        return 0;
+    return written + tail;
+}
+
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE size_t avx512vbmiEncodeShort(const char * src, size_t srclen, char * out)
+{
+    if (srclen <= 48)
+        return encodeShort<1>(src, srclen, out);
+    if (srclen <= 96)
+        return encodeShort<2>(src, srclen, out);
+    return encodeShort<3>(src, srclen, out);
+}
+
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE size_t avx512vbmiDecodeShort(const char * src, size_t srclen, char * out)
+{
+    if (srclen <= 64)
+        return decodeShort<1>(src, srclen, out);
+    if (srclen <= 128)
+        return decodeShort<2>(src, srclen, out);
+    return decodeShort<3>(src, srclen, out);
+}
+
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE size_t avx512vbmiFindInvalid(const char * src, size_t srclen)
+{
+    const __m512i lookup_low = _mm512_load_si512(decodeLookup.data());
+    const __m512i lookup_high = _mm512_load_si512(decodeLookup.data() + 64);
+    const __m512i filler = _mm512_set1_epi8('A');
+
+    for (size_t i = 0; i < srclen; i += 64)
+    {
+        const __m512i input = _mm512_mask_loadu_epi8(filler, prefixMask(srclen - i), src + i);
+        const __m512i values = _mm512_permutex2var_epi8(lookup_low, input, lookup_high);
+        const __mmask64 invalid = _mm512_movepi8_mask(_mm512_or_si512(values, input));
+        if (invalid != 0)
+            return i + static_cast<size_t>(__builtin_ctzll(invalid));
+    }
+    return srclen;
+}
+
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE size_t avx512vbmiEncodeUrl(const char * src, size_t srclen, char * out)
+{
+    size_t i = 0;
+    size_t written = 0;
+    for (; i + 48 <= srclen; i += 48, written += 64)
+        _mm512_storeu_si512(out + written, encodeBlock(_mm512_maskz_loadu_epi8(prefixMask(48), src + i), base64UrlAlphabet));
+
+    // Without padding the tail is just a shorter masked store.
+    const auto tail_size = srclen - i;
+    const auto symbols = (tail_size * 4 + 2) / 3;
+    const __m512i tail = encodeBlock(_mm512_maskz_loadu_epi8(prefixMask(tail_size), src + i), base64UrlAlphabet);
+    _mm512_mask_storeu_epi8(out + written, prefixMask(symbols), tail);
+    return written + symbols;
+}
+
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE size_t avx512vbmiDecodeUrl(const char * src, size_t srclen, char * out)
+{
+    if (srclen == 0 || srclen % 4 == 1)
+        return 0;
+
+    size_t i = 0;
+    size_t written = 0;
+    __mmask64 invalid = 0;
+    for (; i + 64 <= srclen; i += 64, written += 48)
+    {
+        const __m512i decoded = decodeBlock(_mm512_loadu_si512(src + i), invalid, urlDecodeLookup);
+        if (invalid != 0)
+            return 0;
+        _mm512_mask_storeu_epi8(out + written, prefixMask(48), decoded);
+    }
+
+    // The symbols past the end are replaced with 'A', a partial quadruple of 2 or 3 symbols gives 1 or 2 bytes.
+    const auto tail_size = srclen - i;
+    const auto tail_bytes = tail_size / 4 * 3 + (tail_size % 4 == 0 ? 0 : tail_size % 4 - 1);
+    const __m512i input = _mm512_mask_loadu_epi8(_mm512_set1_epi8('A'), prefixMask(tail_size), src + i);
+    const __m512i decoded = decodeBlock(input, invalid, urlDecodeLookup);
+    if (invalid != 0)
+        return 0;
+    _mm512_mask_storeu_epi8(out + written, prefixMask(tail_bytes), decoded);
+    return written + tail_bytes;
+}
+
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE size_t avx512vbmiEncodeMime(const char * src, size_t srclen, char * out)
+{
+    // A line of 57 bytes is one full block and 9 bytes of the next one, whose 12 symbols are stored
+    // together with the line break that is blended in after them.
+    static_assert(mimeLineBytes == 48 + 9);
+    const __m512i line_break = _mm512_set1_epi16('\n' << 8 | '\r');
+    const __mmask64 line_break_mask = __mmask64{0b11} << 12;
+
+    size_t i = 0;
+    size_t written = 0;
+    // Every line that is followed by more input gets a line break, the last one is padded instead.
+    for (; srclen - i > mimeLineBytes; i += mimeLineBytes, written += mimeLineSymbols + 2)
+    {
+        _mm512_storeu_si512(out + written, encodeBlock(_mm512_maskz_loadu_epi8(prefixMask(48), src + i)));
+        const __m512i tail = encodeBlock(_mm512_maskz_loadu_epi8(prefixMask(9), src + i + 48));
+        _mm512_mask_storeu_epi8(out + written + 64, prefixMask(14), _mm512_mask_blend_epi8(line_break_mask, tail, line_break));
+    }
+    return written + avx512vbmiEncodeShort(src + i, srclen - i, out + written);
+}
+
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE size_t avx512vbmiDecodeMime(const char * src, size_t srclen, char * out)
+{
+    const __m512i filler = _mm512_set1_epi8('A');
+
+    // Lines of 76 symbols followed by CRLF are decoded in place, 64 symbols and 12 symbols with a masked load.
+    size_t i = 0;
+    size_t written = 0;
+    while (srclen - i > mimeLineSymbols + 2 && src[i + mimeLineSymbols] == '\r' && src[i + mimeLineSymbols + 1] == '\n')
+    {
+        __mmask64 invalid = 0;
+        const __m512i head = decodeBlock(_mm512_loadu_si512(src + i), invalid);
+        const __m512i tail = decodeBlock(_mm512_mask_loadu_epi8(filler, prefixMask(12), src + i + 64), invalid);
+        // The line may still hold a line break of another layout, the fallback below skips it or rejects the input.
+        if (invalid != 0)
+            break;
+        _mm512_mask_storeu_epi8(out + written, prefixMask(48), head);
+        _mm512_mask_storeu_epi8(out + written + 48, prefixMask(9), tail);
+        i += mimeLineSymbols + 2;
+        written += mimeLineBytes;
+    }
+
+    // The last line has no line breaks left, unless the input ends with one or has another layout.
+    // On failure the short kernel has still stored up to (srclen - i) / 4 * 3 bytes, which fits in the documented bound.
+    if (srclen - i <= avx512ShortDecodeLimit)
+    {
+        const auto last_line = avx512vbmiDecodeShort(src + i, srclen - i, out + written);
+        if (last_line != 0)
+            return written + last_line;
+    }
+
+    // Lines of any other width have their line breaks skipped on the way.
+    size_t outlen = 0;
+    if (!decodeSkippingLineBreaks(src + i, srclen - i, out + written, outlen, avx512vbmiDecode))
+        return 0;
+    return written + outlen;
+}
+
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE size_t avx512vbmiEncodeCrc32c(const char * src, size_t srclen, char * out, uint32_t & crc)
+{
+    uint32_t state = ~crc;
+    size_t i = 0;
+    size_t written = 0;
+    for (; i + 48 <= srclen; i += 48, written += 64)
+    {
+        const __m512i input = _mm512_maskz_loadu_epi8(prefixMask(48), src + i);
+        state = crc32cBlock(state, input);
+        _mm512_storeu_si512(out + written, encodeBlock(input));
+    }
+
+    crc = crc32c(~state, src + i, srclen - i);
+    return written + scalarEncode(src + i, srclen - i, out + written);
+}
+
+AVX512VBMI_FUNCTION_SPECIFIC_ATTRIBUTE size_t avx512vbmiDecodeCrc32c(const char * src, size_t srclen, char * out, uint32_t & crc)
+{
+    if (srclen == 0 || srclen % 4 != 0)
+        return 0;
+
+    uint32_t state = ~crc;
+    size_t i = 0;
+    size_t written = 0;
+    for (; i + 64 < srclen; i += 64, written += 48)
+    {
+        __mmask64 invalid = 0;
+        const __m512i decoded = decodeBlock(_mm512_loadu_si512(src + i), invalid);
+        if (invalid != 0)
+            return 0;
+        state = crc32cBlock(state, decoded);
+        _mm512_mask_storeu_epi8(out + written, prefixMask(48), decoded);
+    }
+
+    const auto tail = scalarDecode(src + i, srclen - i, out + written);
+    if (tail == 0)
+        return 0;
+    crc = crc32c(~state, out + written, tail);
+    return written + tail;
+}
+
+#else
+
+bool hasAvx512Vbmi()
+{
+    return false;
+}
+
+size_t avx512vbmiEncode(const char * src, size_t srclen, char * out)
+{
+    return scalarEncode(src, srclen, out);
+}
+
+size_t avx512vbmiDecode(const char * src, size_t srclen, char * out)
+{
+    return scalarDecode(src, srclen, out);
+}
+
+size_t avx512vbmiEncodeShort(const char * src, size_t srclen, char * out)
+{
+    return scalarEncode(src, srclen, out);
+}
+
+size_t avx512vbmiDecodeShort(const char * src, size_t srclen, char * out)
+{
+    return scalarDecode(src, srclen, out);
+}
+
+size_t avx512vbmiFindInvalid(const char * src, size_t srclen)
+{
+    return scalarFindInvalid(src, srclen);
+}
+
+size_t avx512vbmiEncodeUrl(const char * src, size_t srclen, char * out)
+{
+    return scalarEncodeUrl(src, srclen, out);
+}
+
+size_t avx512vbmiDecodeUrl(const char * src, size_t srclen, char * out)
+{
+    return scalarDecodeUrl(src, srclen, out);
+}
+
+size_t avx512vbmiEncodeMime(const char * src, size_t srclen, char * out)
+{
+    return scalarEncodeMime(src, srclen, out);
+}
+
+size_t avx512vbmiDecodeMime(const char * src, size_t srclen, char * out)
+{
+    return scalarDecodeMime(src, srclen, out);
+}
+
+size_t avx512vbmiEncodeCrc32c(const char * src, size_t srclen, char * out, uint32_t & crc)
+{
+    crc = crc32c(crc, src, srclen);
+    return scalarEncode(src, srclen, out);
+}
+
+size_t avx512vbmiDecodeCrc32c(const char * src, size_t srclen, char * out, uint32_t & crc)
+{
+    const auto written = scalarDecode(src, srclen, out);
+    crc = crc32c(crc, out, written);
+    return written;
+}
+
+#endif
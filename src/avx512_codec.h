@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// base64 with AVX-512 VBMI: 48 input bytes become 64 symbols with two `vpermb` and one `vpmultishiftqb`,
+/// 64 symbols are validated and translated with one `vpermi2b` and packed back into 48 bytes with `vpermb`.
+/// The tails that do not fill a register are handled by the scalar codec. Follows the conventions of codecs.h.
+///
+/// The kernels may only be called when `hasAvx512Vbmi()` is true, `Avx512VbmiBase64` in codecs.h
+/// falls back to the scalar codec otherwise.
+size_t avx512vbmiEncode(const char * src, size_t srclen, char * out);
+size_t avx512vbmiDecode(const char * src, size_t srclen, char * out);
+
+/// Short inputs (up to 3 registers: `avx512ShortEncodeLimit` bytes or `avx512ShortDecodeLimit` symbols)
+/// have their own kernels, specialized on the number of registers, that handle the tail with masked loads
+/// and stores instead of the scalar codec, so that the fixed cost of a call is a few instructions.
+static constexpr size_t avx512ShortEncodeLimit = 3 * 48;
+static constexpr size_t avx512ShortDecodeLimit = 3 * 64;
+
+size_t avx512vbmiEncodeShort(const char * src, size_t srclen, char * out);
+size_t avx512vbmiDecodeShort(const char * src, size_t srclen, char * out);
+
+/// base64url and MIME base64 (see scalar_codec.h) with the alphabet swap and the line breaks done in the kernels:
+/// base64url only swaps the lookup tables and ends with a masked store instead of padding, MIME encoding stores
+/// CRLF together with the last symbols of every line, MIME decoding decodes 76-symbol lines in place
+/// and skips line breaks of any other layout on the way. MIME decoding may store past the decoded size before it rejects
+/// or re-decodes the last line, so `out` must hold `base64DecodedSizeUpperBound(srclen)` bytes (see base64_size.h).
+size_t avx512vbmiEncodeUrl(const char * src, size_t srclen, char * out);
+size_t avx512vbmiDecodeUrl(const char * src, size_t srclen, char * out);
+size_t avx512vbmiEncodeMime(const char * src, size_t srclen, char * out);
+size_t avx512vbmiDecodeMime(const char * src, size_t srclen, char * out);
+
+/// Encoding and decoding that also update the CRC32C (see crc32c.h) of the binary data in `crc`:
+/// every block is checksummed from the register it was loaded into or decoded to, so the data is not read twice.
+size_t avx512vbmiEncodeCrc32c(const char * src, size_t srclen, char * out, uint32_t & crc);
+size_t avx512vbmiDecodeCrc32c(const char * src, size_t srclen, char * out, uint32_t & crc);
+
+/// Offset of the first byte that is not in the alphabet ('=' included), `srclen` if there is none.
+/// The same lookup as in decoding, 64 bytes per instruction, without decoding anything.
+size_t avx512vbmiFindInvalid(const char * src, size_t srclen);
+
+/// Whether the CPU supports AVX-512 F, BW and VBMI and the kernels are compiled in.
+bool hasAvx512Vbmi();
@@ -0,0 +1,66 @@
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "backends.h"
+#include "initializer.h"
+#include "perf_counters.h"
+
+/// The same inputs and size classes as in main.cpp, but for every backend of every library explicitly.
+
+static void BM_BackendEncode(benchmark::State & state, const CodecBackend & backend)
+{
+    const auto idx = state.range(0);
+    const auto input = Initializer::stringsToEncode[idx];
+    const auto size = input.size();
+    state.counters["size"] = static_cast<double>(size);
+    std::string output;
+    output.resize(static_cast<std::size_t>(static_cast<long double>(size) * 1.5));
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        backend.encode(input.data(), size, output.data());
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
+    restoreAklompDispatch();
+}
+
+static void BM_BackendDecode(benchmark::State & state, const CodecBackend & backend)
+{
+    const auto idx = state.range(0);
+    const auto input = Initializer::stringsToDecode[idx];
+    const auto size = input.size();
+    state.counters["size"] = static_cast<double>(size);
+    std::string output;
+    output.resize(size);
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        backend.decode(input.data(), size, output.data());
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
+    restoreAklompDispatch();
+}
+
+static bool registerBackendBenchmarks()
+{
+    for (const auto * direction : {"encode", "decode"})
+    {
+        for (const auto & backend : availableCodecBackends())
+        {
+            for (const auto & size_class : Initializer::sizeClasses)
+            {
+                const auto name = std::string(backend.library) + " " + std::string(backend.name) + " " + direction + " " + size_class.name;
+                auto * function = std::string_view(direction) == "encode" ? BM_BackendEncode : BM_BackendDecode;
+                benchmark::RegisterBenchmark(name.c_str(), function, backend)->DenseRange(size_class.first, size_class.last);
+            }
+        }
+    }
+    return true;
+}
+
+[[maybe_unused]] static const bool backendBenchmarksRegistered = registerBackendBenchmarks();
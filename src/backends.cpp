@@ -0,0 +1,151 @@
+#include "backends.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <libbase64.h>
+#include <turbob64.h>
+
+namespace
+{
+
+bool cpuSupports([[maybe_unused]] std::string_view feature)
+{
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (feature == "ssse3")
+        return __builtin_cpu_supports("ssse3");
+    if (feature == "sse4.1")
+        return __builtin_cpu_supports("sse4.1");
+    if (feature == "sse4.2")
+        return __builtin_cpu_supports("sse4.2");
+    if (feature == "avx")
+        return __builtin_cpu_supports("avx");
+    if (feature == "avx2")
+        return __builtin_cpu_supports("avx2");
+    return false;
+#elif defined(__aarch64__)
+    // NEON is mandatory on AArch64
+    return feature == "neon";
+#else
+    return false;
+#endif
+}
+
+template <int flags>
+size_t aklompEncode(const char * src, size_t srclen, char * out)
+{
+    size_t outlen = 0;
+    base64_encode(src, srclen, out, &outlen, flags);
+    return outlen;
+}
+
+template <int flags>
+size_t aklompDecode(const char * src, size_t srclen, char * out)
+{
+    size_t outlen = 0;
+    if (base64_decode(src, srclen, out, &outlen, flags) != 1)
+        return 0;
+    return outlen;
+}
+
+/// base64_decode returns -1 when the forced codec is not compiled into the library.
+template <int flags>
+bool aklompHasCodec()
+{
+    char out[3];
+    size_t outlen = 0;
+    return base64_decode("AAAA", 4, out, &outlen, flags) != -1;
+}
+
+template <size_t (*function)(const unsigned char *, size_t, unsigned char *)>
+size_t turbo(const char * src, size_t srclen, char * out)
+{
+    return function(reinterpret_cast<const uint8_t *>(src), srclen, reinterpret_cast<uint8_t *>(out));
+}
+
+/// aklomp/base64 keeps a single global codec: a call with a forced codec replaces it for all later calls, even those
+/// with `flags = 0`, and forcing a codec that is not compiled in leaves a stub that fails every call. So the probes
+/// are followed by `forceDispatchedAklomp` and the forced benchmarks by `restoreAklompDispatch`.
+template <int flags>
+void addAklomp(std::vector<CodecBackend> & backends, std::string_view name, std::string_view feature)
+{
+    if ((feature.empty() || cpuSupports(feature)) && aklompHasCodec<flags>())
+        backends.push_back({"aklomp/base64", name, aklompEncode<flags>, aklompDecode<flags>});
+}
+
+/// The library dispatches to the widest code path the CPU supports, which is the last aklomp/base64 backend:
+/// forcing it gives the same codec as the library's own choice.
+void forceDispatchedAklomp(const std::vector<CodecBackend> & backends)
+{
+    const CodecBackend * dispatched = nullptr;
+    for (const auto & backend : backends)
+        if (backend.library == "aklomp/base64")
+            dispatched = &backend;
+    if (!dispatched)
+        return;
+    char out[3];
+    dispatched->decode("AAAA", 4, out);
+}
+
+}
+
+const std::vector<CodecBackend> & availableCodecBackends()
+{
+    static const std::vector<CodecBackend> backends = []
+    {
+        std::vector<CodecBackend> result;
+
+        result.push_back({"Turbo-Base64", "scalar", turbo<tb64senc>, turbo<tb64sdec>});
+        result.push_back({"Turbo-Base64", "fast scalar", turbo<tb64xenc>, turbo<tb64xdec>});
+#if defined(__x86_64__)
+        if (cpuSupports("ssse3"))
+            result.push_back({"Turbo-Base64", "SSSE3", turbo<tb64v128enc>, turbo<tb64v128dec>});
+        if (cpuSupports("avx"))
+            result.push_back({"Turbo-Base64", "AVX", turbo<tb64v128aenc>, turbo<tb64v128adec>});
+        if (cpuSupports("avx2"))
+            result.push_back({"Turbo-Base64", "AVX2", turbo<tb64v256enc>, turbo<tb64v256dec>});
+#elif defined(__aarch64__)
+        result.push_back({"Turbo-Base64", "NEON", turbo<tb64v128enc>, turbo<tb64v128dec>});
+#endif
+
+        addAklomp<BASE64_FORCE_PLAIN>(result, "plain", "");
+#if defined(__x86_64__)
+        addAklomp<BASE64_FORCE_SSSE3>(result, "SSSE3", "ssse3");
+        addAklomp<BASE64_FORCE_SSE41>(result, "SSE4.1", "sse4.1");
+        addAklomp<BASE64_FORCE_SSE42>(result, "SSE4.2", "sse4.2");
+        addAklomp<BASE64_FORCE_AVX>(result, "AVX", "avx");
+        addAklomp<BASE64_FORCE_AVX2>(result, "AVX2", "avx2");
+#elif defined(__aarch64__)
+        addAklomp<BASE64_FORCE_NEON64>(result, "NEON64", "neon");
+#endif
+        forceDispatchedAklomp(result);
+
+        return result;
+    }();
+    return backends;
+}
+
+void restoreAklompDispatch()
+{
+    forceDispatchedAklomp(availableCodecBackends());
+}
+
+const CodecBackend & dispatchedCodecBackend(std::string_view library)
+{
+#if defined(__aarch64__)
+    // codecs.h calls the scalar Turbo-Base64 codec on AArch64, its NEON codec is only benchmarked explicitly.
+    const bool scalar_turbo = library == "Turbo-Base64";
+#else
+    const bool scalar_turbo = false;
+#endif
+    // Both libraries dispatch to the widest code path the CPU supports, which is the last one of the library.
+    const CodecBackend * dispatched = nullptr;
+    for (const auto & backend : availableCodecBackends())
+        if (backend.library == library && (!scalar_turbo || backend.name == "scalar"))
+            dispatched = &backend;
+    if (!dispatched)
+        throw std::runtime_error("No backend of " + std::string(library));
+    return *dispatched;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/// A SIMD (or scalar) code path of one of the libraries, called explicitly instead of through the library's dispatch.
+/// `encode` and `decode` follow the conventions of codecs.h.
+struct CodecBackend
+{
+    std::string_view library;
+    std::string_view name;
+    size_t (*encode)(const char * src, size_t srclen, char * out);
+    size_t (*decode)(const char * src, size_t srclen, char * out);
+};
+
+/// The backends that are both compiled in and supported by the CPU we are running on.
+const std::vector<CodecBackend> & availableCodecBackends();
+
+/// The backend that `library` dispatches to on this CPU when it is called the way codecs.h does it,
+/// so that batches of calls can go to it directly instead of through the dispatch of every call.
+const CodecBackend & dispatchedCodecBackend(std::string_view library);
+
+/// Calling an aklomp/base64 backend forces its codec for all later calls of the library, including the dispatched ones
+/// of codecs.h. Brings back the codec that the library chooses by itself.
+void restoreAklompDispatch();
@@ -0,0 +1,96 @@
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+
+#include "codecs.h"
+#include "file_codec.h"
+#include "initializer.h"
+
+/// Encodes or decodes a file into another file with one of the benchmarked libraries and I/O paths.
+
+static void printUsage(const char * program)
+{
+    std::cerr << "Usage: " << program << " encode|decode INPUT OUTPUT [--library turbo|aklomp] [--io read|mmap"
+#if defined(HAVE_LIBURING)
+              << "|uring"
+#endif
+              << "] [--chunk-size BYTES]\n";
+}
+
+template <typename Codec>
+static bool run(bool encode, FileIO io, int in_fd, int out_fd, size_t chunk_size)
+{
+    return encode ? encodeFile<Codec>(io, in_fd, out_fd, chunk_size) : decodeFile<Codec>(io, in_fd, out_fd, chunk_size);
+}
+
+int main(int argc, char ** argv)
+{
+    if (argc < 4)
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Initializer initializer;
+
+    const std::string_view mode = argv[1];
+    if (mode != "encode" && mode != "decode")
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::string_view library = "aklomp";
+    FileIO io = FileIO::Mmap;
+    size_t chunk_size = 1 << 20;
+    for (int i = 4; i < argc; ++i)
+    {
+        const std::string_view option = argv[i];
+        if (i + 1 == argc)
+        {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        const std::string_view value = argv[++i];
+        if (option == "--library" && (value == "turbo" || value == "aklomp"))
+            library = value;
+        else if (option == "--io" && parseFileIO(value))
+            io = *parseFileIO(value);
+        else if (option == "--chunk-size" && std::strtoull(value.data(), nullptr, 10) != 0)
+            chunk_size = std::strtoull(value.data(), nullptr, 10);
+        else
+        {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    const int in_fd = ::open(argv[2], O_RDONLY);
+    if (in_fd < 0)
+    {
+        std::cerr << "Cannot open " << argv[2] << "\n";
+        return EXIT_FAILURE;
+    }
+    // The output is mapped for writing by the mmap path, which requires it to be opened for reading too.
+    const int out_fd = ::open(argv[3], O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (out_fd < 0)
+    {
+        std::cerr << "Cannot open " << argv[3] << "\n";
+        return EXIT_FAILURE;
+    }
+
+    const bool encode = mode == "encode";
+    const bool ok = library == "turbo" ? run<TurboBase64>(encode, io, in_fd, out_fd, chunk_size)
+                                       : run<AklompBase64>(encode, io, in_fd, out_fd, chunk_size);
+    ::close(in_fd);
+    ::close(out_fd);
+    if (!ok)
+    {
+        std::cerr << "Cannot " << mode << " " << argv[2] << (encode ? ": I/O error" : ": I/O error or invalid base64") << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
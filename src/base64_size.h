@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+
+/// Size of the padded base64 representation of `size` bytes.
+constexpr size_t base64EncodedSize(size_t size)
+{
+    return (size + 2) / 3 * 4;
+}
+
+/// Upper bound of the decoded size of `size` base64 symbols (exact when there is no padding).
+constexpr size_t base64DecodedSizeUpperBound(size_t size)
+{
+    return size / 4 * 3;
+}
+
+/// Decoded size of `size` base64 symbols at `src`, assuming they are valid base64 with padding.
+constexpr size_t base64DecodedSize(const char * src, size_t size)
+{
+    if (size < 4)
+        return 0;
+    return size / 4 * 3 - (src[size - 1] == '=') - (src[size - 2] == '=');
+}
+
+/// Size of the base64url representation (without padding) of `size` bytes.
+constexpr size_t base64UrlEncodedSize(size_t size)
+{
+    return (size * 4 + 2) / 3;
+}
+
+/// Decoded size of `size` base64url symbols without padding.
+constexpr size_t base64UrlDecodedSize(size_t size)
+{
+    return size / 4 * 3 + (size % 4 == 0 ? 0 : size % 4 - 1);
+}
@@ -0,0 +1,105 @@
+#include "cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+
+/// Size of the cache of the `level` reported by the OS, or `fallback` if it does not report it
+/// (e.g. glibc on most AArch64 CPUs, macOS).
+size_t queryCacheSize([[maybe_unused]] int level, size_t fallback)
+{
+#if defined(_SC_LEVEL1_DCACHE_SIZE)
+    const int names[] = {_SC_LEVEL1_DCACHE_SIZE, _SC_LEVEL2_CACHE_SIZE, _SC_LEVEL3_CACHE_SIZE};
+    const auto size = ::sysconf(names[level - 1]);
+    if (size > 0)
+        return static_cast<size_t>(size);
+#endif
+    return fallback;
+}
+
+}
+
+const CacheSizes & cacheSizes()
+{
+    static const CacheSizes sizes{
+        .l1 = queryCacheSize(1, 32 << 10),
+        .l2 = queryCacheSize(2, 1 << 20),
+        .l3 = queryCacheSize(3, 32 << 20),
+    };
+    return sizes;
+}
+
+std::string_view toString(CacheLevel level)
+{
+    switch (level)
+    {
+        case CacheLevel::L1:
+            return "L1";
+        case CacheLevel::L2:
+            return "L2";
+        case CacheLevel::L3:
+            return "L3";
+        case CacheLevel::Dram:
+            return "DRAM";
+    }
+    return "";
+}
+
+size_t workingSetSize(CacheLevel level)
+{
+    const auto & sizes = cacheSizes();
+    switch (level)
+    {
+        case CacheLevel::L1:
+            return sizes.l1 / 2;
+        case CacheLevel::L2:
+            return sizes.l2 / 2;
+        case CacheLevel::L3:
+            return sizes.l3 / 2;
+        case CacheLevel::Dram:
+            return std::max<size_t>(sizes.l3 * 4, 256 << 20);
+    }
+    return 0;
+}
+
+void copyNonTemporal(char * dst, const char * src, size_t size)
+{
+#if defined(__x86_64__)
+    // The streaming stores need 16-byte aligned addresses, the unaligned head goes through the cache.
+    const auto head = std::min(size, (16 - reinterpret_cast<uintptr_t>(dst) % 16) % 16);
+    std::memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    size -= head;
+
+    for (; size >= 64; dst += 64, src += 64, size -= 64)
+    {
+        const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 16));
+        const auto c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 32));
+        const auto d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i *>(dst), a);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 16), b);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 32), c);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 48), d);
+    }
+    for (; size >= 16; dst += 16, src += 16, size -= 16)
+        _mm_stream_si128(reinterpret_cast<__m128i *>(dst), _mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
+#endif
+    std::memcpy(dst, src, size);
+}
+
+void nonTemporalFence()
+{
+#if defined(__x86_64__)
+    _mm_sfence();
+#endif
+}
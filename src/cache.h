@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+/// Data cache sizes of the CPU the benchmark runs on, with typical values where the OS does not report them.
+struct CacheSizes
+{
+    size_t l1;
+    size_t l2;
+    size_t l3;
+};
+
+const CacheSizes & cacheSizes();
+
+/// The level of the memory hierarchy a working set is sized to fit in.
+enum class CacheLevel
+{
+    L1,
+    L2,
+    L3,
+    Dram,
+};
+
+std::string_view toString(CacheLevel level);
+
+/// Half of the cache, so that the working set stays resident along with the stack, the tables of the codecs
+/// and whatever the other hyperthread brings in. DRAM gets 4x the L3, but at least 256MiB.
+size_t workingSetSize(CacheLevel level);
+
+/// Copies `size` bytes with non-temporal stores that bypass the caches, so the output does not evict the input
+/// of the next calls. Falls back to `memcpy` where there are no such stores (everything except x86-64).
+void copyNonTemporal(char * dst, const char * src, size_t size);
+
+/// Makes the non-temporal stores of `copyNonTemporal` visible to the other threads.
+void nonTemporalFence();
+
+/// Software prefetch of every cache line of `size` bytes at `data` into all cache levels.
+inline void prefetchRange(const char * data, size_t size)
+{
+    for (size_t offset = 0; offset < size; offset += 64)
+        __builtin_prefetch(data + offset, 0, 3);
+}
@@ -0,0 +1,177 @@
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "cache.h"
+#include "codecs.h"
+#include "perf_counters.h"
+
+/// Cache residency sweep: the other benchmarks convert the same input into the same output on every iteration,
+/// so both stay in L1. Here every iteration converts the next pair of a pool of distinct input and output buffers
+/// that together take about the size of L1, L2, L3 or much more than L3 (see `workingSetSize`), so the data comes
+/// from that level. Optionally the output is written with non-temporal stores (`nt_stores`: converted into a buffer
+/// in L1 and streamed to the pool, as the libraries do not have such stores themselves), and the input of the next
+/// call is prefetched (`prefetch`).
+
+/// Bytes encoded or decoded by every call: long enough for the vector loops of the libraries,
+/// short enough for the pool to have a few buffers even when it fits in L1.
+static constexpr size_t cacheSweepChunkSize = 1 << 10;
+
+/// Input and output buffers, each one starting at a cache line.
+class BufferPool
+{
+public:
+    BufferPool(size_t working_set, size_t input_size, size_t output_size)
+        : input_stride((input_size + 63) / 64 * 64)
+        , output_stride((output_size + 63) / 64 * 64)
+        , count(std::max<size_t>(working_set / (input_stride + output_stride), 2))
+        , inputs(count * input_stride + 64)
+        , outputs(count * output_stride + 64, '\0')
+    {
+    }
+
+    size_t size() const { return count; }
+    size_t workingSet() const { return count * (input_stride + output_stride); }
+
+    char * input(size_t i) { return alignedStart(inputs) + i * input_stride; }
+    char * output(size_t i) { return alignedStart(outputs) + i * output_stride; }
+
+private:
+    static char * alignedStart(std::vector<char> & buffer)
+    {
+        const auto address = reinterpret_cast<uintptr_t>(buffer.data());
+        return buffer.data() + (64 - address % 64) % 64;
+    }
+
+    size_t input_stride;
+    size_t output_stride;
+    size_t count;
+    std::vector<char> inputs;
+    std::vector<char> outputs;
+};
+
+static void fillRandom(char * data, size_t size, std::mt19937_64 & rng)
+{
+    for (size_t i = 0; i < size; i += 8)
+    {
+        const auto value = rng();
+        std::memcpy(data + i, &value, std::min<size_t>(8, size - i));
+    }
+}
+
+/// Converts the buffers of the pool round-robin with `convert(input, output)` and reports the throughput over the input.
+template <typename Convert>
+static void runCacheSweep(benchmark::State & state, BufferPool & pool, size_t input_size, size_t output_size, Convert && convert)
+{
+    const bool nt_stores = state.range(0) != 0;
+    const bool prefetch = state.range(1) != 0;
+    std::vector<char> scratch(output_size);
+
+    size_t current = 0;
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        const auto next = current + 1 == pool.size() ? 0 : current + 1;
+        if (prefetch)
+            prefetchRange(pool.input(next), input_size);
+
+        if (nt_stores)
+        {
+            const auto written = convert(pool.input(current), scratch.data());
+            copyNonTemporal(pool.output(current), scratch.data(), written);
+            nonTemporalFence();
+        }
+        else
+        {
+            benchmark::DoNotOptimize(convert(pool.input(current), pool.output(current)));
+        }
+        benchmark::ClobberMemory();
+        current = next;
+    }
+
+    state.counters["working_set"] = benchmark::Counter(static_cast<double>(pool.workingSet()), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+    state.counters["buffers"] = static_cast<double>(pool.size());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input_size));
+    perf_counters.report(state);
+}
+
+template <typename Codec>
+static void BM_EncodeCache(benchmark::State & state, CacheLevel level)
+{
+    const auto input_size = cacheSweepChunkSize;
+    const auto output_size = base64EncodedSize(input_size);
+    BufferPool pool(workingSetSize(level), input_size, output_size);
+    std::mt19937_64 rng(42);
+    for (size_t i = 0; i < pool.size(); ++i)
+        fillRandom(pool.input(i), input_size, rng);
+
+    std::string expected(output_size, '\0');
+    AklompBase64::encode(pool.input(0), input_size, expected.data());
+    if (Codec::encode(pool.input(0), input_size, pool.output(0)) != output_size || std::memcmp(pool.output(0), expected.data(), output_size) != 0)
+    {
+        state.SkipWithError("The encoded output differs from aklomp/base64");
+        return;
+    }
+
+    runCacheSweep(state, pool, input_size, output_size, [&](const char * input, char * output)
+    {
+        return Codec::encode(input, input_size, output);
+    });
+}
+
+template <typename Codec>
+static void BM_DecodeCache(benchmark::State & state, CacheLevel level)
+{
+    const auto input_size = base64EncodedSize(cacheSweepChunkSize);
+    const auto output_size = cacheSweepChunkSize;
+    BufferPool pool(workingSetSize(level), input_size, output_size);
+    std::mt19937_64 rng(42);
+    std::string data(output_size, '\0');
+    std::string expected;
+    for (size_t i = 0; i < pool.size(); ++i)
+    {
+        fillRandom(data.data(), output_size, rng);
+        AklompBase64::encode(data.data(), output_size, pool.input(i));
+        if (i == 0)
+            expected = data;
+    }
+
+    if (Codec::decode(pool.input(0), input_size, pool.output(0)) != output_size || std::memcmp(pool.output(0), expected.data(), output_size) != 0)
+    {
+        state.SkipWithError("The decoded output differs from the original data");
+        return;
+    }
+
+    runCacheSweep(state, pool, input_size, output_size, [&](const char * input, char * output)
+    {
+        return Codec::decode(input, input_size, output);
+    });
+}
+
+template <typename Codec>
+static void registerCacheBenchmarks()
+{
+    for (const auto level : {CacheLevel::L1, CacheLevel::L2, CacheLevel::L3, CacheLevel::Dram})
+    {
+        const auto suffix = " " + std::string(toString(level));
+        benchmark::RegisterBenchmark((std::string(Codec::name) + " encode" + suffix).c_str(), BM_EncodeCache<Codec>, level)
+            ->ArgNames({"nt_stores", "prefetch"})
+            ->ArgsProduct({{0, 1}, {0, 1}});
+        benchmark::RegisterBenchmark((std::string(Codec::name) + " decode" + suffix).c_str(), BM_DecodeCache<Codec>, level)
+            ->ArgNames({"nt_stores", "prefetch"})
+            ->ArgsProduct({{0, 1}, {0, 1}});
+    }
+}
+
+static bool registerAllCacheBenchmarks()
+{
+    registerCacheBenchmarks<TurboBase64>();
+    registerCacheBenchmarks<AklompBase64>();
+    registerCacheBenchmarks<Avx512VbmiBase64>();
+    return true;
+}
+
+[[maybe_unused]] static const bool cacheBenchmarksRegistered = registerAllCacheBenchmarks();
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "codecs.h"
+#include "crc32c.h"
+
+/// Encoding and decoding that also compute the CRC32C of the binary data, e.g. for deduplication on ingestion.
+/// The libraries cannot be hooked into, so their input is processed in blocks of one AVX-512 register
+/// (48 bytes to encode, 64 symbols to decode, as in the kernels of `Avx512VbmiBase64`, which checksum every register
+/// themselves): a block is checksummed right after it is converted instead of in a second pass over the whole buffer.
+/// The blocks are much shorter than the inputs, so the libraries pay a call per block for the interleaving.
+static constexpr size_t checksumEncodeBlockSize = 48;
+static constexpr size_t checksumDecodeBlockSize = 64;
+
+/// Encodes `src` into `out` and updates `crc` with `src`.
+template <typename Codec>
+size_t encodeWithCrc32c(const char * src, size_t srclen, char * out, uint32_t & crc)
+{
+    size_t written = 0;
+    for (size_t i = 0; i < srclen; i += checksumEncodeBlockSize)
+    {
+        const auto size = std::min(checksumEncodeBlockSize, srclen - i);
+        crc = crc32c(crc, src + i, size);
+        written += Codec::encode(src + i, size, out + written);
+    }
+    return written;
+}
+
+/// Decodes `src` into `out` and updates `crc` with the decoded data.
+/// Returns 0 on invalid input, padding is only allowed in the last block.
+template <typename Codec>
+size_t decodeWithCrc32c(const char * src, size_t srclen, char * out, uint32_t & crc)
+{
+    size_t written = 0;
+    for (size_t i = 0; i < srclen; i += checksumDecodeBlockSize)
+    {
+        const auto size = std::min(checksumDecodeBlockSize, srclen - i);
+        const auto block = Codec::decode(src + i, size, out + written);
+        if (block == 0 || (i + size < srclen && block != size / 4 * 3))
+            return 0;
+        crc = crc32c(crc, out + written, block);
+        written += block;
+    }
+    return written;
+}
+
+template <>
+inline size_t encodeWithCrc32c<Avx512VbmiBase64>(const char * src, size_t srclen, char * out, uint32_t & crc)
+{
+    if (!hasAvx512Vbmi())
+    {
+        crc = crc32c(crc, src, srclen);
+        return scalarEncode(src, srclen, out);
+    }
+    return avx512vbmiEncodeCrc32c(src, srclen, out, crc);
+}
+
+template <>
+inline size_t decodeWithCrc32c<Avx512VbmiBase64>(const char * src, size_t srclen, char * out, uint32_t & crc)
+{
+    if (!hasAvx512Vbmi())
+    {
+        const auto written = scalarDecode(src, srclen, out);
+        crc = crc32c(crc, out, written);
+        return written;
+    }
+    return avx512vbmiDecodeCrc32c(src, srclen, out, crc);
+}
@@ -0,0 +1,131 @@
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "checksum.h"
+#include "codecs.h"
+#include "initializer.h"
+#include "perf_counters.h"
+
+/// Encoding and decoding with a CRC32C of the binary data at the size classes of main.cpp:
+/// `+ crc32c` is the two-pass baseline (the plain codec call, then a checksum of the whole buffer),
+/// `fused crc32c` checksums the data while it is being converted, see checksum.h.
+
+template <typename Codec>
+struct TwoPassCrc32c
+{
+    static size_t encode(const char * src, size_t srclen, char * out, uint32_t & crc)
+    {
+        const auto written = Codec::encode(src, srclen, out);
+        crc = crc32c(crc, src, srclen);
+        return written;
+    }
+
+    static size_t decode(const char * src, size_t srclen, char * out, uint32_t & crc)
+    {
+        const auto written = Codec::decode(src, srclen, out);
+        crc = crc32c(crc, out, written);
+        return written;
+    }
+};
+
+template <typename Codec>
+struct FusedCrc32c
+{
+    static size_t encode(const char * src, size_t srclen, char * out, uint32_t & crc)
+    {
+        return encodeWithCrc32c<Codec>(src, srclen, out, crc);
+    }
+
+    static size_t decode(const char * src, size_t srclen, char * out, uint32_t & crc)
+    {
+        return decodeWithCrc32c<Codec>(src, srclen, out, crc);
+    }
+};
+
+template <typename Checksummed>
+static void BM_EncodeChecksum(benchmark::State & state)
+{
+    const auto idx = state.range(0);
+    const auto input = Initializer::stringsToEncode[idx];
+    const auto size = input.size();
+    state.counters["size"] = static_cast<double>(size);
+    std::string output;
+    output.resize(base64EncodedSize(size));
+
+    uint32_t crc = 0;
+    Checksummed::encode(input.data(), size, output.data(), crc);
+    if (crc != crc32c(0, input.data(), size))
+    {
+        state.SkipWithError("Wrong checksum");
+        return;
+    }
+
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        crc = 0;
+        Checksummed::encode(input.data(), size, output.data(), crc);
+        benchmark::DoNotOptimize(crc);
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
+}
+
+template <typename Checksummed>
+static void BM_DecodeChecksum(benchmark::State & state)
+{
+    const auto idx = state.range(0);
+    const auto input = Initializer::stringsToDecode[idx];
+    const auto expected = Initializer::stringsToEncode[idx];
+    const auto size = input.size();
+    state.counters["size"] = static_cast<double>(size);
+    std::string output;
+    output.resize(size);
+
+    uint32_t crc = 0;
+    if (Checksummed::decode(input.data(), size, output.data(), crc) != expected.size() || crc != crc32c(0, expected.data(), expected.size()))
+    {
+        state.SkipWithError("Wrong decoded size or checksum");
+        return;
+    }
+
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        crc = 0;
+        Checksummed::decode(input.data(), size, output.data(), crc);
+        benchmark::DoNotOptimize(crc);
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
+}
+
+template <typename Codec>
+static void registerChecksumBenchmarks()
+{
+    for (const auto & size_class : Initializer::sizeClasses)
+    {
+        const auto name = std::string(Codec::name);
+        benchmark::RegisterBenchmark((name + " encode + crc32c " + size_class.name).c_str(), BM_EncodeChecksum<TwoPassCrc32c<Codec>>)
+            ->DenseRange(size_class.first, size_class.last);
+        benchmark::RegisterBenchmark((name + " encode fused crc32c " + size_class.name).c_str(), BM_EncodeChecksum<FusedCrc32c<Codec>>)
+            ->DenseRange(size_class.first, size_class.last);
+        benchmark::RegisterBenchmark((name + " decode + crc32c " + size_class.name).c_str(), BM_DecodeChecksum<TwoPassCrc32c<Codec>>)
+            ->DenseRange(size_class.first, size_class.last);
+        benchmark::RegisterBenchmark((name + " decode fused crc32c " + size_class.name).c_str(), BM_DecodeChecksum<FusedCrc32c<Codec>>)
+            ->DenseRange(size_class.first, size_class.last);
+    }
+}
+
+static bool registerAllChecksumBenchmarks()
+{
+    registerChecksumBenchmarks<TurboBase64>();
+    registerChecksumBenchmarks<AklompBase64>();
+    registerChecksumBenchmarks<Avx512VbmiBase64>();
+    return true;
+}
+
+[[maybe_unused]] static const bool checksumBenchmarksRegistered = registerAllChecksumBenchmarks();
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <libbase64.h>
+#include <turbob64.h>
+
+#include "avx512_codec.h"
+#include "base64_size.h"
+#include "mime.h"
+#include "scalar_codec.h"
+
+/// The codecs below wrap the benchmarked libraries behind the same interface,
+/// so that generic benchmarks can be written once and instantiated per library.
+/// `encode` and `decode` return the number of bytes written, `decode` returns 0 on invalid input.
+/// The standard alphabet codecs also have `encodedSize` and `decodedSize` (for valid input), the exact
+/// sizes of the output, so that it can be allocated without the slack of an upper bound.
+
+struct TurboBase64
+{
+    static constexpr const char * name = "Turbo-Base64";
+
+    static size_t encodedSize(size_t size) { return tb64enclen(size); }
+    static size_t decodedSize(const char * src, size_t size) { return tb64declen(reinterpret_cast<const uint8_t *>(src), size); }
+
+    static size_t encode(const char * src, size_t srclen, char * out)
+    {
+#if defined(__aarch64__)
+        return tb64senc(reinterpret_cast<const uint8_t *>(src), srclen, reinterpret_cast<uint8_t *>(out));
+#else
+        return _tb64e(reinterpret_cast<const uint8_t *>(src), srclen, reinterpret_cast<uint8_t *>(out));
+#endif
+    }
+
+    static size_t decode(const char * src, size_t srclen, char * out)
+    {
+#if defined(__aarch64__)
+        return tb64sdec(reinterpret_cast<const uint8_t *>(src), srclen, reinterpret_cast<uint8_t *>(out));
+#else
+        return _tb64d(reinterpret_cast<const uint8_t *>(src), srclen, reinterpret_cast<uint8_t *>(out));
+#endif
+    }
+};
+
+struct AklompBase64
+{
+    static constexpr const char * name = "aklomp/base64";
+
+    static size_t encodedSize(size_t size) { return base64EncodedSize(size); }
+    static size_t decodedSize(const char * src, size_t size) { return base64DecodedSize(src, size); }
+
+    static size_t encode(const char * src, size_t srclen, char * out)
+    {
+        size_t outlen = 0;
+        base64_encode(src, srclen, out, &outlen, 0);
+        return outlen;
+    }
+
+    static size_t decode(const char * src, size_t srclen, char * out)
+    {
+        size_t outlen = 0;
+        if (base64_decode(src, srclen, out, &outlen, 0) != 1)
+            return 0;
+        return outlen;
+    }
+};
+
+/// Our own AVX-512 VBMI kernels, with the scalar codec on CPUs without AVX-512 VBMI.
+struct Avx512VbmiBase64
+{
+    static constexpr const char * name = "AVX-512 VBMI";
+
+    static size_t encodedSize(size_t size) { return base64EncodedSize(size); }
+    static size_t decodedSize(const char * src, size_t size) { return base64DecodedSize(src, size); }
+
+    static size_t encode(const char * src, size_t srclen, char * out)
+    {
+        return hasAvx512Vbmi() ? avx512vbmiEncode(src, srclen, out) : scalarEncode(src, srclen, out);
+    }
+
+    static size_t decode(const char * src, size_t srclen, char * out)
+    {
+        return hasAvx512Vbmi() ? avx512vbmiDecode(src, srclen, out) : scalarDecode(src, srclen, out);
+    }
+};
+
+/// `Avx512VbmiBase64` with the short input kernels for inputs that fit in 3 registers.
+struct Avx512VbmiShortBase64
+{
+    static constexpr const char * name = "AVX-512 VBMI short";
+
+    static size_t encodedSize(size_t size) { return base64EncodedSize(size); }
+    static size_t decodedSize(const char * src, size_t size) { return base64DecodedSize(src, size); }
+
+    static size_t encode(const char * src, size_t srclen, char * out)
+    {
+        if (!hasAvx512Vbmi())
+            return scalarEncode(src, srclen, out);
+        if (srclen <= avx512ShortEncodeLimit)
+            return avx512vbmiEncodeShort(src, srclen, out);
+        return avx512vbmiEncode(src, srclen, out);
+    }
+
+    static size_t decode(const char * src, size_t srclen, char * out)
+    {
+        if (!hasAvx512Vbmi())
+            return scalarDecode(src, srclen, out);
+        if (srclen <= avx512ShortDecodeLimit)
+            return avx512vbmiDecodeShort(src, srclen, out);
+        return avx512vbmiDecode(src, srclen, out);
+    }
+};
+
+/// base64url without padding with the AVX-512 VBMI kernels, see avx512_codec.h.
+struct Avx512VbmiBase64Url
+{
+    static constexpr const char * name = "AVX-512 VBMI base64url";
+
+    static size_t encode(const char * src, size_t srclen, char * out)
+    {
+        return hasAvx512Vbmi() ? avx512vbmiEncodeUrl(src, srclen, out) : scalarEncodeUrl(src, srclen, out);
+    }
+
+    static size_t decode(const char * src, size_t srclen, char * out)
+    {
+        return hasAvx512Vbmi() ? avx512vbmiDecodeUrl(src, srclen, out) : scalarDecodeUrl(src, srclen, out);
+    }
+};
+
+/// MIME base64 with 76-symbol lines with the AVX-512 VBMI kernels, see avx512_codec.h.
+/// Decoding needs `base64DecodedSizeUpperBound(srclen)` bytes of output, not only the decoded size.
+struct Avx512VbmiBase64Mime
+{
+    static constexpr const char * name = "AVX-512 VBMI MIME";
+
+    static size_t encode(const char * src, size_t srclen, char * out)
+    {
+        return hasAvx512Vbmi() ? avx512vbmiEncodeMime(src, srclen, out) : scalarEncodeMime(src, srclen, out);
+    }
+
+    static size_t decode(const char * src, size_t srclen, char * out)
+    {
+        return hasAvx512Vbmi() ? avx512vbmiDecodeMime(src, srclen, out) : scalarDecodeMime(src, srclen, out);
+    }
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "backends.h"
+#include "codecs.h"
+
+/// A column of strings laid out the way ClickHouse's ColumnString is:
+/// all rows are concatenated into `chars`, `offsets[i]` is the end of row `i`.
+/// `chars` may be longer than `offsets.back()`, the tail is unused.
+struct ColumnString
+{
+    std::vector<char> chars;
+    std::vector<size_t> offsets;
+
+    size_t size() const { return offsets.size(); }
+
+    size_t offsetAt(size_t row) const { return row == 0 ? 0 : offsets[row - 1]; }
+
+    std::string_view at(size_t row) const
+    {
+        const auto begin = offsetAt(row);
+        return {chars.data() + begin, offsets[row] - begin};
+    }
+
+    void insert(std::string_view value)
+    {
+        const auto begin = offsets.empty() ? 0 : offsets.back();
+        chars.resize(begin + value.size());
+        std::memcpy(chars.data() + begin, value.data(), value.size());
+        offsets.push_back(begin + value.size());
+    }
+};
+
+/// The code path that `Codec` (one of the libraries of codecs.h) dispatches to, resolved once, so that the rows
+/// of a column go to the kernel back-to-back instead of through the library's dispatch and codec selection every time.
+template <typename Codec>
+const CodecBackend & columnBackend()
+{
+    static const CodecBackend & backend = dispatchedCodecBackend(Codec::name);
+    return backend;
+}
+
+/// Sets the offsets of `dst` to the ones of the encoded `src` and sizes `dst.chars` accordingly.
+/// When `dst` already has the right shape (e.g. it is reused between blocks), nothing is allocated.
+inline void prepareEncodedColumn(const ColumnString & src, ColumnString & dst)
+{
+    const auto rows = src.size();
+    dst.offsets.resize(rows);
+
+    size_t dst_offset = 0;
+    for (size_t row = 0; row < rows; ++row)
+    {
+        dst_offset += base64EncodedSize(src.offsets[row] - src.offsetAt(row));
+        dst.offsets[row] = dst_offset;
+    }
+    dst.chars.resize(dst_offset);
+}
+
+/// Encodes rows [row_begin, row_end) of `src` into `dst` prepared by `prepareEncodedColumn`.
+/// The offsets of the output only depend on the input, so a fixed column is prepared once and encoded many times.
+template <typename Codec>
+void encodeColumnRows(const ColumnString & src, ColumnString & dst, size_t row_begin, size_t row_end)
+{
+    const auto encode = columnBackend<Codec>().encode;
+    const char * src_chars = src.chars.data();
+    char * dst_chars = dst.chars.data();
+    size_t src_offset = src.offsetAt(row_begin);
+    size_t dst_offset = dst.offsetAt(row_begin);
+    for (size_t row = row_begin; row < row_end; ++row)
+    {
+        encode(src_chars + src_offset, src.offsets[row] - src_offset, dst_chars + dst_offset);
+        src_offset = src.offsets[row];
+        dst_offset = dst.offsets[row];
+    }
+}
+
+/// Encodes every row of `src` into `dst`. The output offsets are known upfront,
+/// so `dst` is sized once and the kernel is called back-to-back for all rows.
+template <typename Codec>
+void encodeColumn(const ColumnString & src, ColumnString & dst)
+{
+    prepareEncodedColumn(src, dst);
+    encodeColumnRows<Codec>(src, dst, 0, src.size());
+}
+
+/// Decodes every row of `src` into `dst`. The decoded size of a row is only known after decoding it,
+/// so `dst.chars` is sized to the upper bound and left that way to avoid reinitializing it on the next block.
+/// Returns false if some row is not valid base64.
+template <typename Codec>
+bool decodeColumn(const ColumnString & src, ColumnString & dst)
+{
+    const auto decode = columnBackend<Codec>().decode;
+    const auto rows = src.size();
+    dst.offsets.resize(rows);
+    dst.chars.resize(base64DecodedSizeUpperBound(src.chars.size()));
+
+    const char * src_chars = src.chars.data();
+    char * dst_chars = dst.chars.data();
+    size_t src_offset = 0;
+    size_t dst_offset = 0;
+    for (size_t row = 0; row < rows; ++row)
+    {
+        const auto srclen = src.offsets[row] - src_offset;
+        if (srclen != 0)
+        {
+            const auto outlen = decode(src_chars + src_offset, srclen, dst_chars + dst_offset);
+            if (outlen == 0)
+                return false;
+            dst_offset += outlen;
+        }
+        dst.offsets[row] = dst_offset;
+        src_offset = src.offsets[row];
+    }
+    return true;
+}
+
+/// Sets the offsets of `dst` to the ones of the decoded `src`, assuming that every row is valid base64 with padding
+/// (see `base64DecodedSize`), and sizes `dst.chars` accordingly, so that ranges of rows can be decoded independently.
+inline void prepareDecodedColumn(const ColumnString & src, ColumnString & dst)
+{
+    const auto rows = src.size();
+    dst.offsets.resize(rows);
+
+    size_t dst_offset = 0;
+    for (size_t row = 0; row < rows; ++row)
+    {
+        const auto begin = src.offsetAt(row);
+        dst_offset += base64DecodedSize(src.chars.data() + begin, src.offsets[row] - begin);
+        dst.offsets[row] = dst_offset;
+    }
+    dst.chars.resize(dst_offset);
+}
+
+/// Decodes rows [row_begin, row_end) of `src` into `dst` prepared by `prepareDecodedColumn`.
+/// Returns false if some row is not valid base64.
+template <typename Codec>
+bool decodeColumnRows(const ColumnString & src, ColumnString & dst, size_t row_begin, size_t row_end)
+{
+    const auto decode = columnBackend<Codec>().decode;
+    const char * src_chars = src.chars.data();
+    char * dst_chars = dst.chars.data();
+    size_t src_offset = src.offsetAt(row_begin);
+    size_t dst_offset = dst.offsetAt(row_begin);
+    for (size_t row = row_begin; row < row_end; ++row)
+    {
+        const auto srclen = src.offsets[row] - src_offset;
+        if (srclen != 0 && decode(src_chars + src_offset, srclen, dst_chars + dst_offset) != dst.offsets[row] - dst_offset)
+            return false;
+        src_offset = src.offsets[row];
+        dst_offset = dst.offsets[row];
+    }
+    return true;
+}
@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include "codecs.h"
+#include "column.h"
+#include "initializer.h"
+#include "perf_counters.h"
+
+/// Column benchmarks encode and decode a whole block of rows at once, the way a database does it.
+/// Rows are taken from the ~50, ~100 and ~200 symbols inputs, where the per-call overhead is the most visible.
+static constexpr size_t columnInputs = 9;
+
+static ColumnString makeColumn(const std::array<std::string_view, 15> & strings, size_t rows)
+{
+    ColumnString column;
+    column.offsets.reserve(rows);
+    for (size_t row = 0; row < rows; ++row)
+        column.insert(strings[row % columnInputs]);
+    return column;
+}
+
+static void setColumnCounters(benchmark::State & state, const ColumnString & input)
+{
+    const auto rows = static_cast<double>(input.size());
+    state.counters["rows_per_second"] = benchmark::Counter(rows * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.offsets.back()));
+}
+
+template <typename Codec>
+static void BM_EncodeColumn(benchmark::State & state)
+{
+    const auto input = makeColumn(Initializer::stringsToEncode, static_cast<size_t>(state.range(0)));
+    ColumnString output;
+    // The offsets of the output only depend on the input, so they are computed once outside of the loop.
+    encodeColumn<Codec>(input, output);
+    const auto rows = input.size();
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        encodeColumnRows<Codec>(input, output, 0, rows);
+        benchmark::DoNotOptimize(output.chars.data());
+        benchmark::ClobberMemory();
+    }
+    setColumnCounters(state, input);
+    perf_counters.report(state);
+}
+
+template <typename Codec>
+static void BM_DecodeColumn(benchmark::State & state)
+{
+    const auto input = makeColumn(Initializer::stringsToDecode, static_cast<size_t>(state.range(0)));
+    ColumnString output;
+    if (!decodeColumn<Codec>(input, output))
+    {
+        state.SkipWithError("Invalid base64 in the input column");
+        return;
+    }
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        decodeColumn<Codec>(input, output);
+        benchmark::DoNotOptimize(output.chars.data());
+        benchmark::ClobberMemory();
+    }
+    setColumnCounters(state, input);
+    perf_counters.report(state);
+}
+
+BENCHMARK_TEMPLATE(BM_EncodeColumn, TurboBase64)->RangeMultiplier(8)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond)->Name("Turbo-Base64 encode column");
+BENCHMARK_TEMPLATE(BM_EncodeColumn, AklompBase64)->RangeMultiplier(8)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond)->Name("aklomp/base64 encode column");
+
+BENCHMARK_TEMPLATE(BM_DecodeColumn, TurboBase64)->RangeMultiplier(8)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond)->Name("Turbo-Base64 decode column");
+BENCHMARK_TEMPLATE(BM_DecodeColumn, AklompBase64)->RangeMultiplier(8)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond)->Name("aklomp/base64 decode column");
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "results.h"
+
+/// Compares two runs of base64-benchmark from the results store (see results.h) and fails if some benchmark
+/// became slower by more than the threshold, beyond the noise of the repetitions. Exit codes: 0 if there are
+/// no regressions, 1 if there are, 2 on invalid arguments or files.
+
+static constexpr int exitRegression = 1;
+static constexpr int exitError = 2;
+
+/// The fingerprint keys that make runs incomparable when they differ, see fingerprint.h.
+static constexpr std::string_view fingerprintKeys[] = {
+    "cpu_model",
+    "cpu_flags",
+    "compiler",
+    "turbo_base64_backend",
+    "aklomp_base64_backend",
+    "avx512vbmi_backend",
+    "build_type",
+    /// Written by Google Benchmark itself: the build type of the benchmark library.
+    "library_build_type",
+};
+
+static void printUsage(const char * program)
+{
+    std::cerr << "Usage: " << program << " BASELINE.json CURRENT.json [--threshold PERCENT]\n"
+              << "The files are written by base64-benchmark --results_store=DIR, "
+                 "run it with --benchmark_repetitions=N (N >= 5) for the noise estimate.\n";
+}
+
+static std::string contextValue(const BenchmarkRun & run, std::string_view key)
+{
+    for (const auto & [name, value] : run.context)
+        if (name == key)
+            return value;
+    return "";
+}
+
+static bool compareFingerprints(const BenchmarkRun & baseline, const BenchmarkRun & current)
+{
+    bool same = true;
+    for (const auto key : fingerprintKeys)
+    {
+        const auto before = contextValue(baseline, key);
+        const auto after = contextValue(current, key);
+        if (before == after)
+            continue;
+        std::cerr << "Warning: " << key << " differs: '" << before << "' in the baseline, '" << after << "' now\n";
+        same = false;
+    }
+    return same;
+}
+
+static void printComparison(const BenchmarkComparison & comparison, double threshold, size_t name_width)
+{
+    std::string_view verdict = "same";
+    if (!comparison.significant)
+        verdict = "noise";
+    else if (comparison.slowdown > threshold)
+        verdict = "REGRESSION";
+    else if (comparison.slowdown < -threshold)
+        verdict = "faster";
+
+    const auto noise = [](double mad, double median) { return median > 0 ? mad / median * 100 : 0; };
+    std::cout << std::left << std::setw(static_cast<int>(name_width)) << comparison.name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(9) << comparison.slowdown * 100 << "%"
+              << "  ±" << std::setw(5) << noise(comparison.baseline_mad, comparison.baseline_median) << "%"
+              << " ±" << std::setw(5) << noise(comparison.current_mad, comparison.current_median) << "%"
+              << std::setw(5) << comparison.baseline_repetitions << std::setw(5) << comparison.current_repetitions
+              << "  " << verdict << "\n";
+}
+
+int main(int argc, char ** argv)
+{
+    if (argc != 3 && argc != 5)
+    {
+        printUsage(argv[0]);
+        return exitError;
+    }
+
+    double threshold = 0.05;
+    if (argc == 5)
+    {
+        char * end = nullptr;
+        const auto percent = std::strtod(argv[4], &end);
+        if (std::string_view(argv[3]) != "--threshold" || *end != '\0' || percent < 0)
+        {
+            printUsage(argv[0]);
+            return exitError;
+        }
+        threshold = percent / 100;
+    }
+
+    BenchmarkRun baseline;
+    BenchmarkRun current;
+    try
+    {
+        baseline = readBenchmarkRun(argv[1]);
+        current = readBenchmarkRun(argv[2]);
+    }
+    catch (const std::runtime_error & e)
+    {
+        std::cerr << e.what() << "\n";
+        return exitError;
+    }
+
+    if (!compareFingerprints(baseline, current))
+        std::cerr << "The runs are from different machines or builds, the differences may not be regressions\n";
+
+    const auto comparisons = compareRuns(baseline, current);
+    size_t name_width = 10;
+    for (const auto & comparison : comparisons)
+        name_width = std::max(name_width, comparison.name.size() + 2);
+
+    std::cout << std::left << std::setw(static_cast<int>(name_width)) << "Benchmark" << std::right
+              << "  slowdown  base MAD  cur MAD base  cur  verdict\n";
+    size_t regressions = 0;
+    size_t single_repetitions = 0;
+    for (const auto & comparison : comparisons)
+    {
+        printComparison(comparison, threshold, name_width);
+        if (comparison.significant && comparison.slowdown > threshold)
+            ++regressions;
+        if (comparison.baseline_repetitions < 2 || comparison.current_repetitions < 2)
+            ++single_repetitions;
+    }
+
+    std::set<std::string> compared;
+    for (const auto & comparison : comparisons)
+        compared.insert(comparison.name);
+    size_t missing = 0;
+    for (const auto & samples : baseline.benchmarks)
+        missing += !compared.contains(samples.name);
+
+    std::cout << "\n" << comparisons.size() << " benchmarks compared, " << regressions << " slower by more than "
+              << threshold * 100 << "%";
+    if (missing != 0)
+        std::cout << ", " << missing << " of the baseline not in the current run";
+    std::cout << "\n";
+    if (single_repetitions != 0)
+        std::cerr << "Warning: " << single_repetitions
+                  << " benchmarks have a single repetition, there is no noise estimate for them\n";
+
+    return regressions == 0 ? EXIT_SUCCESS : exitRegression;
+}
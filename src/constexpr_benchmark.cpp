@@ -0,0 +1,87 @@
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "codecs.h"
+#include "constexpr_codec.h"
+#include "initializer.h"
+#include "perf_counters.h"
+
+/// The header-only constexpr codec at run time, at the size classes of main.cpp: its output is checked against
+/// aklomp/base64, and its numbers are to be compared with the "Turbo-Base64" and "aklomp/base64" ones of main.cpp.
+
+/// The compile-time path, checked when this file is compiled.
+static_assert(std::string_view(base64EncodeLiteral("hello").data(), 8) == "aGVsbG8=");
+static_assert(std::string_view(base64EncodeLiteral("hi").data(), 4) == "aGk=");
+static_assert(base64EncodeArray(std::array<uint8_t, 3>{0xFB, 0xFF, 0xBF}) == std::array<char, 4>{'+', '/', '+', '/'});
+static_assert(std::string_view(base64DecodeLiteral<"aGVsbG8=">().data(), 5) == "hello");
+static_assert(base64DecodeLiteral<"">().empty());
+
+template <typename Codec>
+static void BM_ConstexprEncode(benchmark::State & state)
+{
+    const auto idx = state.range(0);
+    const auto input = Initializer::stringsToEncode[idx];
+    const auto size = input.size();
+    state.counters["size"] = static_cast<double>(size);
+    std::string output;
+    output.resize(Codec::encodedSize(size));
+    std::string expected;
+    expected.resize(base64EncodedSize(size));
+    AklompBase64::encode(input.data(), size, expected.data());
+    if (Codec::encode(input.data(), size, output.data()) != expected.size() || output != expected)
+    {
+        state.SkipWithError("The encoded output differs from aklomp/base64");
+        return;
+    }
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        Codec::encode(input.data(), size, output.data());
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
+}
+
+template <typename Codec>
+static void BM_ConstexprDecode(benchmark::State & state)
+{
+    const auto idx = state.range(0);
+    const auto input = Initializer::stringsToDecode[idx];
+    const auto expected = Initializer::stringsToEncode[idx];
+    const auto size = input.size();
+    state.counters["size"] = static_cast<double>(size);
+    std::string output;
+    output.resize(Codec::decodedSize(input.data(), size));
+    if (Codec::decode(input.data(), size, output.data()) != expected.size() || output != expected)
+    {
+        state.SkipWithError("The decoded output differs from the original data");
+        return;
+    }
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        Codec::decode(input.data(), size, output.data());
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
+}
+
+static bool registerConstexprBenchmarks()
+{
+    for (const auto & size_class : Initializer::sizeClasses)
+    {
+        const auto name = std::string(ConstexprBase64::name);
+        benchmark::RegisterBenchmark((name + " encode " + size_class.name).c_str(), BM_ConstexprEncode<ConstexprBase64>)
+            ->DenseRange(size_class.first, size_class.last);
+        benchmark::RegisterBenchmark((name + " decode " + size_class.name).c_str(), BM_ConstexprDecode<ConstexprBase64>)
+            ->DenseRange(size_class.first, size_class.last);
+    }
+    return true;
+}
+
+[[maybe_unused]] static const bool constexprBenchmarksRegistered = registerConstexprBenchmarks();
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+#include "base64_size.h"
+
+/// A header-only base64 codec whose functions are constexpr, so the same code encodes and decodes at compile time
+/// (constants, embedded certificates and the like: see `base64EncodeLiteral` and `base64DecodeLiteral`)
+/// and at run time (see `ConstexprBase64`). The lookup tables are generated at compile time as well.
+/// The conventions are those of codecs.h: padded output, decoding requires padding and returns 0 on invalid input.
+
+inline constexpr std::string_view base64Symbols = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/// The two symbols of every 12-bit value, so that 3 bytes are encoded with two lookups.
+inline constexpr std::array<char, 2 * 4096> base64SymbolPairs = []
+{
+    std::array<char, 2 * 4096> table{};
+    for (size_t i = 0; i < 4096; ++i)
+    {
+        table[2 * i] = base64Symbols[i >> 6];
+        table[2 * i + 1] = base64Symbols[i & 0x3F];
+    }
+    return table;
+}();
+
+/// Set in a decoded quadruple if one of its symbols is invalid, every valid quadruple fits in 24 bits.
+inline constexpr uint32_t base64InvalidQuadruple = 1 << 24;
+
+/// The value of a symbol at each of the 4 positions of a quadruple, already shifted to its place in the 24 bits,
+/// so that a quadruple is decoded with 4 lookups and 3 ORs. `base64InvalidQuadruple` for symbols out of the alphabet.
+inline constexpr std::array<std::array<uint32_t, 256>, 4> base64DecodeTables = []
+{
+    std::array<std::array<uint32_t, 256>, 4> tables{};
+    for (size_t position = 0; position < 4; ++position)
+    {
+        tables[position].fill(base64InvalidQuadruple);
+        for (size_t i = 0; i < base64Symbols.size(); ++i)
+            tables[position][static_cast<uint8_t>(base64Symbols[i])] = static_cast<uint32_t>(i) << (18 - 6 * position);
+    }
+    return tables;
+}();
+
+constexpr size_t constexprBase64Encode(const char * src, size_t srclen, char * out)
+{
+    const auto byte = [&](size_t i) { return uint32_t{static_cast<uint8_t>(src[i])}; };
+
+    size_t i = 0;
+    size_t written = 0;
+    for (; i + 3 <= srclen; i += 3, written += 4)
+    {
+        const auto value = (byte(i) << 16) | (byte(i + 1) << 8) | byte(i + 2);
+        const auto high = (value >> 12) * 2;
+        const auto low = (value & 0xFFF) * 2;
+        out[written] = base64SymbolPairs[high];
+        out[written + 1] = base64SymbolPairs[high + 1];
+        out[written + 2] = base64SymbolPairs[low];
+        out[written + 3] = base64SymbolPairs[low + 1];
+    }
+
+    const auto rest = srclen - i;
+    if (rest != 0)
+    {
+        const auto value = (byte(i) << 16) | (rest == 2 ? byte(i + 1) << 8 : 0);
+        out[written] = base64Symbols[value >> 18];
+        out[written + 1] = base64Symbols[(value >> 12) & 0x3F];
+        out[written + 2] = rest == 2 ? base64Symbols[(value >> 6) & 0x3F] : '=';
+        out[written + 3] = '=';
+        written += 4;
+    }
+    return written;
+}
+
+constexpr size_t constexprBase64Decode(const char * src, size_t srclen, char * out)
+{
+    if (srclen == 0 || srclen % 4 != 0)
+        return 0;
+    const auto lookup = [&](size_t position, size_t i) { return base64DecodeTables[position][static_cast<uint8_t>(src[i])]; };
+
+    // Padding is only allowed in the last quadruple, which is decoded separately.
+    const auto last = srclen - 4;
+    size_t written = 0;
+    for (size_t i = 0; i < last; i += 4, written += 3)
+    {
+        const auto value = lookup(0, i) | lookup(1, i + 1) | lookup(2, i + 2) | lookup(3, i + 3);
+        if (value & base64InvalidQuadruple)
+            return 0;
+        out[written] = static_cast<char>(value >> 16);
+        out[written + 1] = static_cast<char>(value >> 8);
+        out[written + 2] = static_cast<char>(value);
+    }
+
+    const auto padding = src[last + 3] != '=' ? 0 : src[last + 2] != '=' ? 1 : 2;
+    auto value = lookup(0, last) | lookup(1, last + 1);
+    if (padding < 2)
+        value |= lookup(2, last + 2);
+    if (padding < 1)
+        value |= lookup(3, last + 3);
+    if (value & base64InvalidQuadruple)
+        return 0;
+    out[written++] = static_cast<char>(value >> 16);
+    if (padding < 2)
+        out[written++] = static_cast<char>(value >> 8);
+    if (padding < 1)
+        out[written++] = static_cast<char>(value);
+    return written;
+}
+
+/// Base64 of binary data known at compile time, e.g. `constexpr auto encoded = base64EncodeArray(certificate);`.
+template <typename Byte, size_t N>
+requires(sizeof(Byte) == 1)
+constexpr std::array<char, base64EncodedSize(N)> base64EncodeArray(const std::array<Byte, N> & data)
+{
+    std::array<char, N> input{};
+    for (size_t i = 0; i < N; ++i)
+        input[i] = static_cast<char>(data[i]);
+    std::array<char, base64EncodedSize(N)> result{};
+    constexprBase64Encode(input.data(), N, result.data());
+    return result;
+}
+
+/// Base64 of a string literal without its terminating zero: `base64EncodeLiteral("hello")` is "aGVsbG8=".
+template <size_t N>
+consteval std::array<char, base64EncodedSize(N - 1)> base64EncodeLiteral(const char (&literal)[N])
+{
+    std::array<char, base64EncodedSize(N - 1)> result{};
+    constexprBase64Encode(literal, N - 1, result.data());
+    return result;
+}
+
+/// A string literal as a template argument, the size of the decoded data depends on its padding.
+template <size_t N>
+struct Base64Literal
+{
+    consteval Base64Literal(const char (&literal)[N])
+    {
+        for (size_t i = 0; i < N; ++i)
+            data[i] = literal[i];
+    }
+
+    static constexpr size_t size = N - 1;
+    char data[N];
+};
+
+/// The bytes of a base64 literal: `base64DecodeLiteral<"aGVsbG8=">()` is "hello". Invalid base64 does not compile.
+template <Base64Literal Encoded>
+consteval std::array<char, base64DecodedSize(Encoded.data, Encoded.size)> base64DecodeLiteral()
+{
+    std::array<char, base64DecodedSize(Encoded.data, Encoded.size)> result{};
+    if (constexprBase64Decode(Encoded.data, Encoded.size, result.data()) != result.size())
+        throw std::invalid_argument("Invalid base64 literal");
+    return result;
+}
+
+/// The same functions at run time, with the interface of codecs.h.
+struct ConstexprBase64
+{
+    static constexpr const char * name = "header-only constexpr";
+
+    static size_t encodedSize(size_t size) { return base64EncodedSize(size); }
+    static size_t decodedSize(const char * src, size_t size) { return base64DecodedSize(src, size); }
+
+    static size_t encode(const char * src, size_t srclen, char * out) { return constexprBase64Encode(src, srclen, out); }
+    static size_t decode(const char * src, size_t srclen, char * out) { return constexprBase64Decode(src, srclen, out); }
+};
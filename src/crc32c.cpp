@@ -0,0 +1,79 @@
+#include "crc32c.h"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+namespace
+{
+
+/// The reflected polynomial 0x1EDC6F41.
+constexpr std::array<uint32_t, 256> crc32cTable = []
+{
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        uint32_t value = i;
+        for (int bit = 0; bit < 8; ++bit)
+            value = (value >> 1) ^ (value & 1 ? 0x82F63B78 : 0);
+        table[i] = value;
+    }
+    return table;
+}();
+
+uint32_t crc32cSoftware(uint32_t state, const uint8_t * data, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+        state = crc32cTable[(state ^ data[i]) & 0xFF] ^ (state >> 8);
+    return state;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) uint32_t crc32cHardware(uint32_t state, const uint8_t * data, size_t size)
+{
+    uint64_t state64 = state;
+    for (; size >= 8; data += 8, size -= 8)
+    {
+        uint64_t value;
+        std::memcpy(&value, data, 8);
+        state64 = _mm_crc32_u64(state64, value);
+    }
+    state = static_cast<uint32_t>(state64);
+    for (; size != 0; ++data, --size)
+        state = _mm_crc32_u8(state, *data);
+    return state;
+}
+#elif defined(__ARM_FEATURE_CRC32)
+uint32_t crc32cHardware(uint32_t state, const uint8_t * data, size_t size)
+{
+    for (; size >= 8; data += 8, size -= 8)
+    {
+        uint64_t value;
+        std::memcpy(&value, data, 8);
+        state = __crc32cd(state, value);
+    }
+    for (; size != 0; ++data, --size)
+        state = __crc32cb(state, *data);
+    return state;
+}
+#endif
+
+}
+
+uint32_t crc32c(uint32_t crc, const char * data, size_t size)
+{
+    const auto * bytes = reinterpret_cast<const uint8_t *>(data);
+#if defined(__x86_64__)
+    static const bool hardware = __builtin_cpu_supports("sse4.2");
+    if (hardware)
+        return ~crc32cHardware(~crc, bytes, size);
+#elif defined(__ARM_FEATURE_CRC32)
+    return ~crc32cHardware(~crc, bytes, size);
+#endif
+    return ~crc32cSoftware(~crc, bytes, size);
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// CRC32C (Castagnoli) of `size` bytes, continuing from `crc` (0 for the first call),
+/// e.g. crc32c(0, "123456789", 9) == 0xE3069283. Uses the CRC32 instruction of SSE4.2 or ARMv8 when available.
+uint32_t crc32c(uint32_t crc, const char * data, size_t size);
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "codecs.h"
+#include "constexpr_codec.h"
+
+/// A coroutine that starts right away and is not awaited by anyone, its frame is destroyed when it finishes.
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() { }
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+/// Encodes requests of many concurrent callers in batches: `co_await service.encode(input)` suspends the caller
+/// until its request is encoded. The executor thread waits until the pending requests have `max_bytes` bytes
+/// or the oldest one has waited `max_delay`, then encodes the whole batch and resumes the callers on its own thread.
+///
+/// With `coalesce`, the batch is encoded in one pass: the whole 3-byte groups of all the requests are gathered
+/// into one buffer and encoded with one call, so short requests do not waste the SIMD width on their own calls;
+/// the groups are independent, so every request gets its part of the output back, and the last 1 or 2 bytes
+/// of a request are encoded inline with the scalar code of constexpr_codec.h instead of another call of the codec.
+/// Without it, every request of the batch is encoded with its own call.
+///
+/// The input must stay valid until the caller is resumed.
+template <typename Codec>
+class EncodeService
+{
+public:
+    struct Statistics
+    {
+        size_t batches = 0;
+        size_t requests = 0;
+    };
+
+    EncodeService(std::chrono::microseconds max_delay_, size_t max_bytes_, bool coalesce_)
+        : max_delay(max_delay_)
+        , max_bytes(max_bytes_)
+        , coalesce(coalesce_)
+        , executor([this] { run(); })
+    {
+    }
+
+    /// Encodes the remaining requests and stops the executor.
+    ~EncodeService()
+    {
+        {
+            std::lock_guard lock(mutex);
+            stop = true;
+        }
+        has_requests.notify_one();
+        executor.join();
+    }
+
+    EncodeService(const EncodeService &) = delete;
+    EncodeService & operator=(const EncodeService &) = delete;
+
+    class Awaitable;
+
+    Awaitable encode(std::string_view input) { return Awaitable(*this, input); }
+
+    Statistics statistics() const
+    {
+        std::lock_guard lock(mutex);
+        return totals;
+    }
+
+    class Awaitable
+    {
+    public:
+        Awaitable(EncodeService & service_, std::string_view input_) : service(service_), input(input_) { }
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { service.submit({input, handle, &result}); }
+        std::string await_resume() { return std::move(result); }
+
+    private:
+        EncodeService & service;
+        std::string_view input;
+        std::string result;
+    };
+
+private:
+    struct Request
+    {
+        std::string_view input;
+        std::coroutine_handle<> handle;
+        std::string * result;
+    };
+
+    void submit(const Request & request)
+    {
+        bool wake_up = false;
+        {
+            std::lock_guard lock(mutex);
+            if (pending.empty())
+            {
+                oldest_request = std::chrono::steady_clock::now();
+                wake_up = true;
+            }
+            pending.push_back(request);
+            pending_bytes += request.input.size();
+            wake_up = wake_up || pending_bytes >= max_bytes;
+        }
+        if (wake_up)
+            has_requests.notify_one();
+    }
+
+    void run()
+    {
+        std::vector<Request> batch;
+        std::unique_lock lock(mutex);
+        while (true)
+        {
+            has_requests.wait(lock, [this] { return stop || !pending.empty(); });
+            if (pending.empty())
+                return;
+            has_requests.wait_until(lock, oldest_request + max_delay, [this] { return stop || pending_bytes >= max_bytes; });
+
+            batch.swap(pending);
+            pending_bytes = 0;
+            ++totals.batches;
+            totals.requests += batch.size();
+            lock.unlock();
+
+            if (coalesce)
+                encodeCoalesced(batch);
+            else
+                for (const auto & request : batch)
+                    encodeOne(request);
+            // A resumed caller may submit its next request right away, it goes to the next batch.
+            for (const auto & request : batch)
+                request.handle.resume();
+            batch.clear();
+
+            lock.lock();
+        }
+    }
+
+    static void encodeOne(const Request & request)
+    {
+        request.result->resize(base64EncodedSize(request.input.size()));
+        Codec::encode(request.input.data(), request.input.size(), request.result->data());
+    }
+
+    void encodeCoalesced(const std::vector<Request> & batch)
+    {
+        gathered.clear();
+        for (const auto & request : batch)
+            gathered.append(request.input.data(), request.input.size() / 3 * 3);
+        encoded.resize(base64EncodedSize(gathered.size()));
+        if (!gathered.empty())
+            Codec::encode(gathered.data(), gathered.size(), encoded.data());
+
+        size_t offset = 0;
+        for (const auto & request : batch)
+        {
+            const auto groups = request.input.size() / 3;
+            auto & result = *request.result;
+            result.resize(base64EncodedSize(request.input.size()));
+            std::memcpy(result.data(), encoded.data() + offset, groups * 4);
+            offset += groups * 4;
+            if (const auto rest = request.input.size() - groups * 3; rest != 0)
+                constexprBase64Encode(request.input.data() + groups * 3, rest, result.data() + groups * 4);
+        }
+    }
+
+    const std::chrono::microseconds max_delay;
+    const size_t max_bytes;
+    const bool coalesce;
+
+    mutable std::mutex mutex;
+    std::condition_variable has_requests;
+    std::vector<Request> pending;
+    size_t pending_bytes = 0;
+    std::chrono::steady_clock::time_point oldest_request;
+    Statistics totals;
+    bool stop = false;
+
+    /// Only used by the executor thread.
+    std::string gathered;
+    std::string encoded;
+
+    std::thread executor;
+};
@@ -0,0 +1,128 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "codecs.h"
+#include "file_codec.h"
+#include "initializer.h"
+#include "perf_counters.h"
+#include "temporary_file.h"
+
+/// File to file benchmarks: every I/O path of file_codec.h for both libraries, plus a plain copy of the file
+/// through mmap, which is the upper bound of what an end-to-end conversion can achieve.
+static constexpr size_t fileInputSize = 128 << 20;
+static constexpr size_t fileChunkSize = 1 << 20;
+
+static std::string makeFileInput()
+{
+    // The codecs do not branch on the data, so its contents do not matter.
+    std::mt19937_64 generator(42);
+    std::string data(fileInputSize, '\0');
+    for (size_t i = 0; i + sizeof(uint64_t) <= data.size(); i += sizeof(uint64_t))
+    {
+        const auto value = generator();
+        std::memcpy(data.data() + i, &value, sizeof(value));
+    }
+    return data;
+}
+
+static std::string encodeFileInput(const std::string & data)
+{
+    std::string encoded(base64EncodedSize(data.size()), '\0');
+    AklompBase64::encode(data.data(), data.size(), encoded.data());
+    return encoded;
+}
+
+static TemporaryFile & fileInput()
+{
+    static TemporaryFile file("file-input", makeFileInput());
+    return file;
+}
+
+static TemporaryFile & fileEncodedInput()
+{
+    static TemporaryFile file("file-encoded-input", encodeFileInput(fileInput().read()));
+    return file;
+}
+
+template <typename Function>
+static void runFile(benchmark::State & state, TemporaryFile & input, TemporaryFile & expected, Function && function)
+{
+    TemporaryFile output("file-output");
+    auto run = [&]
+    {
+        input.rewind();
+        output.truncate();
+        return function(input.fd(), output.fd());
+    };
+
+    if (!run() || output.read() != expected.read())
+    {
+        state.SkipWithError("The output file differs from the expected one");
+        return;
+    }
+
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        if (!run())
+        {
+            state.SkipWithError("I/O error");
+            return;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(fileSize(input.fd())));
+    perf_counters.report(state);
+}
+
+template <typename Codec>
+static void registerFileBenchmarks(const std::vector<FileIO> & paths)
+{
+    for (const auto io : paths)
+    {
+        const auto suffix = " file " + std::string(toString(io));
+        benchmark::RegisterBenchmark((std::string(Codec::name) + " encode" + suffix).c_str(), [io](benchmark::State & state)
+        {
+            runFile(state, fileInput(), fileEncodedInput(), [io](int in_fd, int out_fd)
+            {
+                return encodeFile<Codec>(io, in_fd, out_fd, fileChunkSize);
+            });
+        })->UseRealTime()->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark((std::string(Codec::name) + " decode" + suffix).c_str(), [io](benchmark::State & state)
+        {
+            runFile(state, fileEncodedInput(), fileInput(), [io](int in_fd, int out_fd)
+            {
+                return decodeFile<Codec>(io, in_fd, out_fd, fileChunkSize);
+            });
+        })->UseRealTime()->Unit(benchmark::kMillisecond);
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    Initializer initializer;
+
+    const std::vector<FileIO> paths = {
+        FileIO::ReadWrite,
+        FileIO::Mmap,
+#if defined(HAVE_LIBURING)
+        FileIO::MmapUring,
+#endif
+    };
+
+    benchmark::RegisterBenchmark("memcpy file mmap", [](benchmark::State & state)
+    {
+        runFile(state, fileInput(), fileInput(), copyFileMmap);
+    })->UseRealTime()->Unit(benchmark::kMillisecond);
+    registerFileBenchmarks<TurboBase64>(paths);
+    registerFileBenchmarks<AklompBase64>(paths);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include "file_codec.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(HAVE_LIBURING)
+#include <liburing.h>
+#endif
+
+std::string_view toString(FileIO io)
+{
+    switch (io)
+    {
+        case FileIO::ReadWrite:
+            return "read/write";
+        case FileIO::Mmap:
+            return "mmap";
+#if defined(HAVE_LIBURING)
+        case FileIO::MmapUring:
+            return "mmap+io_uring";
+#endif
+    }
+    return "unknown";
+}
+
+std::optional<FileIO> parseFileIO(std::string_view name)
+{
+    if (name == "read" || name == "read/write")
+        return FileIO::ReadWrite;
+    if (name == "mmap")
+        return FileIO::Mmap;
+#if defined(HAVE_LIBURING)
+    if (name == "uring" || name == "mmap+io_uring")
+        return FileIO::MmapUring;
+#endif
+    return std::nullopt;
+}
+
+ssize_t fileSize(int fd)
+{
+    struct stat st{};
+    if (::fstat(fd, &st) != 0)
+        return -1;
+    return st.st_size;
+}
+
+MappedFile::MappedFile(int fd, size_t size, bool writable)
+    : size_(size)
+{
+    if (size == 0)
+        return;
+
+    void * address = ::mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED)
+        return;
+    data_ = static_cast<char *>(address);
+
+    // The input is read once from the beginning to the end, so the kernel can read ahead aggressively.
+    if (!writable)
+        ::madvise(address, size, MADV_SEQUENTIAL);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr)
+        ::munmap(data_, size_);
+}
+
+bool copyFileMmap(int in_fd, int out_fd)
+{
+    const auto size = fileSize(in_fd);
+    if (size < 0 || ::ftruncate(out_fd, size) != 0)
+        return false;
+
+    MappedFile input(in_fd, static_cast<size_t>(size), false);
+    MappedFile output(out_fd, static_cast<size_t>(size), true);
+    if (!input.valid() || !output.valid())
+        return false;
+    if (input.size() != 0)
+        std::memcpy(output.data(), input.data(), input.size());
+    return true;
+}
+
+#if defined(HAVE_LIBURING)
+UringWriter::UringWriter(int fd_, size_t buffer_size)
+    : fd(fd_)
+    , ring(new io_uring)
+{
+    for (auto & buffer : buffers)
+        buffer.data.resize(buffer_size);
+    initialized = io_uring_queue_init(2, ring, 0) == 0;
+}
+
+UringWriter::~UringWriter()
+{
+    if (initialized)
+    {
+        finish();
+        io_uring_queue_exit(ring);
+    }
+    delete ring;
+}
+
+char * UringWriter::buffer()
+{
+    while (buffers[current].in_flight)
+    {
+        if (!waitOne())
+            return nullptr;
+    }
+    return buffers[current].data.data();
+}
+
+bool UringWriter::submit(size_t size)
+{
+    auto & buffer = buffers[current];
+    buffer.size = size;
+    buffer.offset = offset;
+    offset += static_cast<off_t>(size);
+    current = 1 - current;
+    if (size == 0)
+        return true;
+
+    io_uring_sqe * sqe = io_uring_get_sqe(ring);
+    if (sqe == nullptr)
+        return false;
+    io_uring_prep_write(sqe, fd, buffer.data.data(), static_cast<unsigned>(size), static_cast<uint64_t>(buffer.offset));
+    io_uring_sqe_set_data(sqe, &buffer);
+    buffer.in_flight = true;
+    return io_uring_submit(ring) == 1;
+}
+
+bool UringWriter::finish()
+{
+    while (buffers[0].in_flight || buffers[1].in_flight)
+    {
+        if (!waitOne())
+            return false;
+    }
+    return !failed;
+}
+
+bool UringWriter::waitOne()
+{
+    io_uring_cqe * cqe = nullptr;
+    if (io_uring_wait_cqe(ring, &cqe) != 0)
+    {
+        failed = true;
+        return false;
+    }
+    auto & buffer = *static_cast<Buffer *>(io_uring_cqe_get_data(cqe));
+    const auto res = cqe->res;
+    io_uring_cqe_seen(ring, cqe);
+    buffer.in_flight = false;
+
+    if (res < 0)
+    {
+        failed = true;
+        return false;
+    }
+
+    // A short write is rare for regular files, the rest is written synchronously.
+    const auto written = static_cast<size_t>(res);
+    if (written < buffer.size)
+    {
+        for (size_t position = written; position < buffer.size;)
+        {
+            const auto res_write = ::pwrite(fd, buffer.data.data() + position, buffer.size - position, buffer.offset + static_cast<off_t>(position));
+            if (res_write <= 0)
+            {
+                failed = true;
+                return false;
+            }
+            position += static_cast<size_t>(res_write);
+        }
+    }
+    return true;
+}
+#endif
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "codecs.h"
+#include "stream.h"
+
+/// File to file encoding and decoding with different I/O paths:
+/// - ReadWrite: read a chunk, convert it, write it (see stream.h), two copies between the kernel and user space;
+/// - Mmap: map the input with MADV_SEQUENTIAL and the output, convert from one mapping to the other, no copies;
+/// - MmapUring: map the input, convert it chunk by chunk into two buffers that are written with io_uring,
+///   so that one chunk is converted while the previous one is being written. Only available with liburing.
+enum class FileIO
+{
+    ReadWrite,
+    Mmap,
+#if defined(HAVE_LIBURING)
+    MmapUring,
+#endif
+};
+
+std::string_view toString(FileIO io);
+std::optional<FileIO> parseFileIO(std::string_view name);
+
+/// Size of the file behind `fd`, or -1 on error.
+ssize_t fileSize(int fd);
+
+/// A read-only or read-write shared mapping of the first `size` bytes of a file.
+/// Empty files are not mapped and have a null `data()`.
+class MappedFile
+{
+public:
+    MappedFile(int fd, size_t size, bool writable);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    bool valid() const { return size_ == 0 || data_ != nullptr; }
+    char * data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    char * data_ = nullptr;
+    size_t size_ = 0;
+};
+
+#if defined(HAVE_LIBURING)
+/// Writes consecutive parts of a file through io_uring with two buffers:
+/// the caller fills one buffer while the other one is being written.
+class UringWriter
+{
+public:
+    UringWriter(int fd, size_t buffer_size);
+    ~UringWriter();
+
+    UringWriter(const UringWriter &) = delete;
+    UringWriter & operator=(const UringWriter &) = delete;
+
+    bool valid() const { return initialized; }
+
+    /// A free buffer of `buffer_size` bytes, waits for its previous write if needed. Null on a write error.
+    char * buffer();
+
+    /// Writes the first `size` bytes of the buffer returned by `buffer` after the previously submitted data.
+    bool submit(size_t size);
+
+    /// Waits for all the writes. Returns false if some of them failed.
+    bool finish();
+
+private:
+    struct Buffer
+    {
+        std::vector<char> data;
+        size_t size = 0;
+        off_t offset = 0;
+        bool in_flight = false;
+    };
+
+    bool waitOne();
+
+    int fd;
+    bool initialized = false;
+    bool failed = false;
+    off_t offset = 0;
+    size_t current = 0;
+    Buffer buffers[2];
+    struct io_uring * ring;
+};
+#endif
+
+/// Copies a file from one mapping to the other, the upper bound for all the paths above.
+bool copyFileMmap(int in_fd, int out_fd);
+
+template <typename Codec>
+bool encodeFileMmap(int in_fd, int out_fd)
+{
+    const auto size = fileSize(in_fd);
+    if (size < 0)
+        return false;
+    const auto out_size = base64EncodedSize(static_cast<size_t>(size));
+    if (::ftruncate(out_fd, static_cast<off_t>(out_size)) != 0)
+        return false;
+
+    MappedFile input(in_fd, static_cast<size_t>(size), false);
+    MappedFile output(out_fd, out_size, true);
+    if (!input.valid() || !output.valid())
+        return false;
+    if (input.size() != 0)
+        Codec::encode(input.data(), input.size(), output.data());
+    return true;
+}
+
+template <typename Codec>
+bool decodeFileMmap(int in_fd, int out_fd)
+{
+    const auto size = fileSize(in_fd);
+    if (size < 0)
+        return false;
+    MappedFile input(in_fd, static_cast<size_t>(size), false);
+    if (!input.valid())
+        return false;
+    if (input.size() % 4 != 0)
+        return false;
+
+    const auto out_size = base64DecodedSize(input.data(), input.size());
+    if (::ftruncate(out_fd, static_cast<off_t>(out_size)) != 0)
+        return false;
+    MappedFile output(out_fd, out_size, true);
+    if (!output.valid())
+        return false;
+    return input.size() == 0 || Codec::decode(input.data(), input.size(), output.data()) == out_size;
+}
+
+#if defined(HAVE_LIBURING)
+template <typename Codec>
+bool encodeFileMmapUring(int in_fd, int out_fd, size_t chunk_size)
+{
+    const auto size = fileSize(in_fd);
+    if (size < 0 || ::ftruncate(out_fd, 0) != 0)
+        return false;
+    MappedFile input(in_fd, static_cast<size_t>(size), false);
+    if (!input.valid())
+        return false;
+
+    // Every chunk except the last one must be a multiple of 3 bytes to be encoded without padding.
+    chunk_size = std::max<size_t>(chunk_size / 3 * 3, 3);
+    UringWriter writer(out_fd, base64EncodedSize(chunk_size));
+    if (!writer.valid())
+        return false;
+
+    for (size_t offset = 0; offset < input.size(); offset += chunk_size)
+    {
+        char * buffer = writer.buffer();
+        if (buffer == nullptr)
+            return false;
+        const auto written = Codec::encode(input.data() + offset, std::min(chunk_size, input.size() - offset), buffer);
+        if (!writer.submit(written))
+            return false;
+    }
+    return writer.finish();
+}
+
+template <typename Codec>
+bool decodeFileMmapUring(int in_fd, int out_fd, size_t chunk_size)
+{
+    const auto size = fileSize(in_fd);
+    if (size < 0 || ::ftruncate(out_fd, 0) != 0)
+        return false;
+    MappedFile input(in_fd, static_cast<size_t>(size), false);
+    if (!input.valid() || input.size() % 4 != 0)
+        return false;
+
+    // Padding may only be in the last chunk, so every chunk is a multiple of 4 symbols.
+    chunk_size = std::max<size_t>(chunk_size / 4 * 4, 4);
+    UringWriter writer(out_fd, base64DecodedSizeUpperBound(chunk_size));
+    if (!writer.valid())
+        return false;
+
+    for (size_t offset = 0; offset < input.size(); offset += chunk_size)
+    {
+        char * buffer = writer.buffer();
+        if (buffer == nullptr)
+            return false;
+        const auto written = Codec::decode(input.data() + offset, std::min(chunk_size, input.size() - offset), buffer);
+        if (written == 0 || !writer.submit(written))
+            return false;
+    }
+    return writer.finish();
+}
+#endif
+
+/// Encodes the file behind `in_fd` into `out_fd`, which is truncated. Both files must be at their beginning.
+/// `chunk_size` is ignored by the Mmap path. Returns false on an I/O error.
+template <typename Codec>
+bool encodeFile(FileIO io, int in_fd, int out_fd, size_t chunk_size)
+{
+    switch (io)
+    {
+        case FileIO::ReadWrite:
+            return ::ftruncate(out_fd, 0) == 0 && streamEncode<Codec>(in_fd, out_fd, chunk_size);
+        case FileIO::Mmap:
+            return encodeFileMmap<Codec>(in_fd, out_fd);
+#if defined(HAVE_LIBURING)
+        case FileIO::MmapUring:
+            return encodeFileMmapUring<Codec>(in_fd, out_fd, chunk_size);
+#endif
+    }
+    return false;
+}
+
+/// Decodes the file behind `in_fd` into `out_fd`, which is truncated. Both files must be at their beginning.
+/// `chunk_size` is ignored by the Mmap path. Returns false on an I/O error or invalid input.
+template <typename Codec>
+bool decodeFile(FileIO io, int in_fd, int out_fd, size_t chunk_size)
+{
+    switch (io)
+    {
+        case FileIO::ReadWrite:
+            return ::ftruncate(out_fd, 0) == 0 && streamDecode<Codec>(in_fd, out_fd, chunk_size);
+        case FileIO::Mmap:
+            return decodeFileMmap<Codec>(in_fd, out_fd);
+#if defined(HAVE_LIBURING)
+        case FileIO::MmapUring:
+            return decodeFileMmapUring<Codec>(in_fd, out_fd, chunk_size);
+#endif
+    }
+    return false;
+}
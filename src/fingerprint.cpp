@@ -0,0 +1,122 @@
+#include "fingerprint.h"
+
+#include <fstream>
+#include <string_view>
+
+#include <turbob64.h>
+
+#include "avx512_codec.h"
+#include "backends.h"
+
+namespace
+{
+
+std::string cpuModel()
+{
+#if defined(__linux__)
+    // "model name" on x86, AArch64 kernels only report the implementer and part numbers.
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    std::string implementer;
+    while (std::getline(cpuinfo, line))
+    {
+        const auto colon = line.find(':');
+        if (colon == std::string::npos)
+            continue;
+        auto key = line.substr(0, colon);
+        key.erase(key.find_last_not_of(" \t") + 1);
+        auto value = line.substr(std::min(colon + 2, line.size()));
+        if (key == "model name")
+            return value;
+        if (key == "CPU implementer")
+            implementer = value;
+        else if (key == "CPU part" && !implementer.empty())
+            return "implementer " + implementer + " part " + value;
+    }
+#endif
+    return "unknown";
+}
+
+std::string cpuFlags()
+{
+    std::string flags;
+    const auto add = [&](std::string_view flag, bool supported)
+    {
+        if (!supported)
+            return;
+        if (!flags.empty())
+            flags += ' ';
+        flags += flag;
+    };
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    add("ssse3", __builtin_cpu_supports("ssse3"));
+    add("sse4.1", __builtin_cpu_supports("sse4.1"));
+    add("sse4.2", __builtin_cpu_supports("sse4.2"));
+    add("avx", __builtin_cpu_supports("avx"));
+    add("avx2", __builtin_cpu_supports("avx2"));
+    add("avx512f", __builtin_cpu_supports("avx512f"));
+    add("avx512bw", __builtin_cpu_supports("avx512bw"));
+    add("avx512vbmi", hasAvx512Vbmi());
+#elif defined(__aarch64__)
+    add("neon", true);
+#if defined(__ARM_FEATURE_CRC32)
+    add("crc32", true);
+#endif
+#endif
+    return flags;
+}
+
+std::string compiler()
+{
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#else
+    return "unknown";
+#endif
+}
+
+/// What `TurboBase64` of codecs.h calls: the scalar codec on AArch64, elsewhere the code path `tb64ini` picked
+/// for the instruction set that Turbo-Base64 itself detected.
+std::string turboBackend()
+{
+#if defined(__aarch64__)
+    return "scalar";
+#else
+    return cpustr(cpuini(0));
+#endif
+}
+
+/// aklomp/base64 has no way to ask for its codec, but `availableCodecBackends` forces the one its dispatch picks.
+std::string aklompBackend()
+{
+    return std::string(dispatchedCodecBackend("aklomp/base64").name);
+}
+
+/// CMAKE_BUILD_TYPE of the benchmarks and the codec libraries, which are built together.
+std::string buildType()
+{
+#if defined(BASE64_BENCHMARK_BUILD_TYPE)
+    const std::string_view build_type = BASE64_BENCHMARK_BUILD_TYPE;
+    return build_type.empty() ? "none" : std::string(build_type);
+#else
+    return "unknown";
+#endif
+}
+
+}
+
+std::vector<std::pair<std::string, std::string>> machineFingerprint()
+{
+    return {
+        {"cpu_model", cpuModel()},
+        {"cpu_flags", cpuFlags()},
+        {"compiler", compiler()},
+        {"turbo_base64_backend", turboBackend()},
+        {"aklomp_base64_backend", aklompBackend()},
+        {"avx512vbmi_backend", hasAvx512Vbmi() ? "AVX-512 VBMI" : "scalar"},
+        {"build_type", buildType()},
+    };
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/// What a benchmark run depends on besides the code: the CPU, the compiler, the build type (CMAKE_BUILD_TYPE)
+/// and the code paths the codecs pick on this CPU.
+/// It is stored along with the results (see results.h), so that runs from different machines are not compared unawares.
+/// Every entry is a key and a value, e.g. {"cpu_model", "Intel(R) Xeon(R) Platinum 8375C CPU @ 2.90GHz"}.
+std::vector<std::pair<std::string, std::string>> machineFingerprint();
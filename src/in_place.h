@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include "codecs.h"
+
+/// Symbols decoded at once by `decodeInPlace`, the stack buffer fits in L1 together with them.
+static constexpr size_t inPlaceDecodeBlockSize = 4 << 10;
+
+/// Decodes `size` symbols at `data` over themselves: the output is shorter than the input, so no second buffer is needed.
+/// Returns the decoded size, or 0 on invalid input (then `data` is partially overwritten).
+///
+/// The libraries do not promise that their output may overlap their input, so every block is decoded into a buffer
+/// on the stack and copied back. A block's output never reaches the part of the input that is still to be read.
+template <typename Codec>
+size_t decodeInPlace(char * data, size_t size)
+{
+    char block[inPlaceDecodeBlockSize / 4 * 3];
+    size_t written = 0;
+    for (size_t i = 0; i < size; i += inPlaceDecodeBlockSize)
+    {
+        const auto symbols = std::min(inPlaceDecodeBlockSize, size - i);
+        const auto decoded = Codec::decode(data + i, symbols, block);
+        // Padding is only allowed in the last block.
+        if (decoded == 0 || (i + symbols < size && decoded != symbols / 4 * 3))
+            return 0;
+        std::memcpy(data + written, block, decoded);
+        written += decoded;
+    }
+    return written;
+}
+
+/// The AVX-512 VBMI and scalar kernels read every block (or quadruple) before writing its output
+/// and never write past the decoded bytes, so they decode in place directly.
+template <>
+inline size_t decodeInPlace<Avx512VbmiBase64>(char * data, size_t size)
+{
+    return Avx512VbmiBase64::decode(data, size, data);
+}
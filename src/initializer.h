@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+
+#include <libbase64.h>
+#include <turbob64.h>
+
+inline void initializeAklompBase64()
+{
+    size_t outlen = 0;
+    base64_encode(nullptr, 0, nullptr, &outlen, 0);
+}
+
+class Initializer
+{
+public:
+    Initializer()
+    {
+        // Initialize Turbo-Base64
+        tb64ini(0, 0);
+        // Initialize Aklomp Base64
+        initializeAklompBase64();
+    }
+
+    static const std::array<std::string_view, 15> stringsToEncode;
+    static const std::array<std::string_view, 15> stringsToDecode;
+
+    /// The size classes of main.cpp: names and ranges of indices in the arrays above.
+    struct SizeClass
+    {
+        const char * name;
+        int first;
+        int last;
+    };
+    static constexpr SizeClass sizeClasses[] = {
+        {"~50 symbols", 0, 2},
+        {"~100 symbols", 3, 5},
+        {"~200 symbols", 6, 8},
+        {"~500 symbols", 9, 11},
+        {"longest in ClickBench", 12, 14},
+    };
+
+private:
+    static const std::string_view longestSearchPhrase;
+    static const std::string_view longestSearchPhraseBase64;
+
+    static const std::string_view longestURL;
+    static const std::string_view longestURLBase64;
+
+    static const std::string_view longestTitle;
+    static const std::string_view longestTitleBase64;
+};
@@ -0,0 +1,275 @@
+#include "json.h"
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+
+class JsonParser
+{
+public:
+    explicit JsonParser(std::string_view text_) : text(text_) { }
+
+    JsonValue parseDocument()
+    {
+        auto value = parseValue();
+        skipWhitespace();
+        if (pos != text.size())
+            fail("unexpected data after the value");
+        return value;
+    }
+
+private:
+    [[noreturn]] void fail(std::string_view message) const
+    {
+        throw std::runtime_error("Invalid JSON at offset " + std::to_string(pos) + ": " + std::string(message));
+    }
+
+    void skipWhitespace()
+    {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r'))
+            ++pos;
+    }
+
+    bool consume(std::string_view token)
+    {
+        if (text.substr(pos, token.size()) != token)
+            return false;
+        pos += token.size();
+        return true;
+    }
+
+    void expect(char c)
+    {
+        skipWhitespace();
+        if (pos == text.size() || text[pos] != c)
+            fail(std::string("expected '") + c + "'");
+        ++pos;
+    }
+
+    JsonValue parseValue()
+    {
+        skipWhitespace();
+        if (pos == text.size())
+            fail("unexpected end of input");
+
+        JsonValue value;
+        switch (text[pos])
+        {
+            case '{':
+                value.type = JsonValue::Object;
+                parseObject(value);
+                return value;
+            case '[':
+                value.type = JsonValue::Array;
+                parseArray(value);
+                return value;
+            case '"':
+                value.type = JsonValue::String;
+                value.string = parseString();
+                return value;
+            default:
+                break;
+        }
+
+        if (consume("null"))
+            return value;
+        if (consume("true"))
+        {
+            value.type = JsonValue::Bool;
+            value.boolean = true;
+            return value;
+        }
+        if (consume("false"))
+        {
+            value.type = JsonValue::Bool;
+            return value;
+        }
+
+        value.type = JsonValue::Number;
+        if (consume("NaN"))
+            value.number = std::numeric_limits<double>::quiet_NaN();
+        else if (consume("Infinity"))
+            value.number = std::numeric_limits<double>::infinity();
+        else if (consume("-Infinity"))
+            value.number = -std::numeric_limits<double>::infinity();
+        else
+            value.number = parseNumber();
+        return value;
+    }
+
+    void parseObject(JsonValue & value)
+    {
+        ++pos;
+        skipWhitespace();
+        if (consume("}"))
+            return;
+        while (true)
+        {
+            skipWhitespace();
+            if (pos == text.size() || text[pos] != '"')
+                fail("expected a member name");
+            auto key = parseString();
+            expect(':');
+            value.object.emplace_back(std::move(key), parseValue());
+            skipWhitespace();
+            if (consume("}"))
+                return;
+            expect(',');
+        }
+    }
+
+    void parseArray(JsonValue & value)
+    {
+        ++pos;
+        skipWhitespace();
+        if (consume("]"))
+            return;
+        while (true)
+        {
+            value.array.push_back(parseValue());
+            skipWhitespace();
+            if (consume("]"))
+                return;
+            expect(',');
+        }
+    }
+
+    double parseNumber()
+    {
+        const auto begin = pos;
+        while (pos < text.size() && (std::isdigit(static_cast<unsigned char>(text[pos])) || text[pos] == '-' || text[pos] == '+'
+                                     || text[pos] == '.' || text[pos] == 'e' || text[pos] == 'E'))
+            ++pos;
+        const std::string number(text.substr(begin, pos - begin));
+        char * end = nullptr;
+        const auto result = std::strtod(number.c_str(), &end);
+        if (number.empty() || end != number.c_str() + number.size())
+        {
+            pos = begin;
+            fail("invalid value");
+        }
+        return result;
+    }
+
+    /// Escapes other than \uXXXX are decoded, \uXXXX is converted to UTF-8 (surrogate pairs included).
+    std::string parseString()
+    {
+        ++pos;
+        std::string result;
+        while (true)
+        {
+            if (pos == text.size())
+                fail("unterminated string");
+            const char c = text[pos++];
+            if (c == '"')
+                return result;
+            if (c != '\\')
+            {
+                result += c;
+                continue;
+            }
+            if (pos == text.size())
+                fail("unterminated string");
+            switch (const char escaped = text[pos++])
+            {
+                case 'b':
+                    result += '\b';
+                    break;
+                case 'f':
+                    result += '\f';
+                    break;
+                case 'n':
+                    result += '\n';
+                    break;
+                case 'r':
+                    result += '\r';
+                    break;
+                case 't':
+                    result += '\t';
+                    break;
+                case 'u':
+                    appendUtf8(result, parseCodePoint());
+                    break;
+                default:
+                    result += escaped;
+            }
+        }
+    }
+
+    uint32_t parseHex4()
+    {
+        if (pos + 4 > text.size())
+            fail("invalid \\u escape");
+        uint32_t value = 0;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            const char c = text[pos++];
+            value <<= 4;
+            if (c >= '0' && c <= '9')
+                value |= c - '0';
+            else if (c >= 'a' && c <= 'f')
+                value |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+                value |= c - 'A' + 10;
+            else
+                fail("invalid \\u escape");
+        }
+        return value;
+    }
+
+    uint32_t parseCodePoint()
+    {
+        const auto high = parseHex4();
+        if (high < 0xD800 || high > 0xDBFF || !consume("\\u"))
+            return high;
+        const auto low = parseHex4();
+        return 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00);
+    }
+
+    static void appendUtf8(std::string & out, uint32_t code_point)
+    {
+        if (code_point < 0x80)
+            out += static_cast<char>(code_point);
+        else if (code_point < 0x800)
+        {
+            out += static_cast<char>(0xC0 | (code_point >> 6));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else if (code_point < 0x10000)
+        {
+            out += static_cast<char>(0xE0 | (code_point >> 12));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else
+        {
+            out += static_cast<char>(0xF0 | (code_point >> 18));
+            out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+    }
+
+    std::string_view text;
+    size_t pos = 0;
+};
+
+}
+
+const JsonValue * JsonValue::find(std::string_view key) const
+{
+    for (const auto & [name, value] : object)
+        if (name == key)
+            return &value;
+    return nullptr;
+}
+
+JsonValue parseJson(std::string_view text)
+{
+    return JsonParser(text).parseDocument();
+}
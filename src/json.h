@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/// A minimal JSON document model, enough to read back the output of Google Benchmark's JSON reporter.
+/// Besides standard JSON it accepts NaN, Infinity and -Infinity, which the reporter writes for such values.
+struct JsonValue
+{
+    enum Type
+    {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object,
+    };
+
+    Type type = Null;
+    bool boolean = false;
+    double number = 0;
+    std::string string;
+    std::vector<JsonValue> array;
+    /// In the order of the document.
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    /// The member `key` of an object, or null if there is no such member or this is not an object.
+    const JsonValue * find(std::string_view key) const;
+};
+
+/// Throws std::runtime_error with the offset of the error on invalid input.
+JsonValue parseJson(std::string_view text);
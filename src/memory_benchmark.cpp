@@ -0,0 +1,157 @@
+#include <cstring>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "codecs.h"
+#include "in_place.h"
+#include "initializer.h"
+#include "memory_usage.h"
+#include "perf_counters.h"
+
+/// Memory footprint benchmarks: a 64MiB blob is encoded or decoded with the output allocated per call,
+/// either with the slack of main.cpp (1.5x the input to encode, the input size to decode), with the exact size,
+/// or, for decoding, without an output buffer at all. Besides the throughput they report the size of the output buffer,
+/// the peak resident set size of the process and how much it grew during the run.
+static constexpr size_t memoryInputSize = 64 << 20;
+
+enum class OutputBuffer
+{
+    /// Sized the way main.cpp does it.
+    UpperBound,
+    /// Sized with `Codec::encodedSize`/`Codec::decodedSize`.
+    Exact,
+    /// Decoded over the input with `decodeInPlace`.
+    InPlace,
+};
+
+static const std::string & memoryInput()
+{
+    static const std::string data = []
+    {
+        std::string result;
+        result.reserve(memoryInputSize);
+        for (size_t i = 0; result.size() < memoryInputSize; ++i)
+            result.append(Initializer::stringsToEncode[i % Initializer::stringsToEncode.size()]);
+        result.resize(memoryInputSize);
+        return result;
+    }();
+    return data;
+}
+
+static const std::string & memoryEncodedInput()
+{
+    static const std::string encoded = []
+    {
+        const auto & data = memoryInput();
+        std::string result(base64EncodedSize(data.size()), '\0');
+        AklompBase64::encode(data.data(), data.size(), result.data());
+        return result;
+    }();
+    return encoded;
+}
+
+/// Runs `function` in the benchmark loop, `prepare` is called before every iteration outside of the timing.
+template <typename Prepare, typename Function>
+static void runMemory(benchmark::State & state, size_t input_size, size_t output_buffer_size, Prepare && prepare, Function && function)
+{
+    const auto memory_usage_before = currentMemoryUsage();
+    resetPeakMemoryUsage();
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        state.PauseTiming();
+        prepare();
+        state.ResumeTiming();
+        function();
+        benchmark::ClobberMemory();
+    }
+    const auto peak_memory_usage = peakMemoryUsage();
+
+    state.counters["output_buffer"] = benchmark::Counter(static_cast<double>(output_buffer_size), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+    state.counters["peak_rss"] = benchmark::Counter(static_cast<double>(peak_memory_usage), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+    state.counters["rss_growth"] = benchmark::Counter(
+        static_cast<double>(peak_memory_usage > memory_usage_before ? peak_memory_usage - memory_usage_before : 0),
+        benchmark::Counter::kDefaults,
+        benchmark::Counter::kIs1024);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input_size));
+    perf_counters.report(state);
+}
+
+template <typename Codec, OutputBuffer Output>
+static void BM_EncodeMemory(benchmark::State & state)
+{
+    const auto & input = memoryInput();
+    const auto size = input.size();
+    const auto output_size = Output == OutputBuffer::Exact
+        ? Codec::encodedSize(size)
+        : static_cast<std::size_t>(static_cast<long double>(size) * 1.5);
+
+    runMemory(state, size, output_size, [] {}, [&]
+    {
+        std::string output;
+        output.resize(output_size);
+        Codec::encode(input.data(), size, output.data());
+        benchmark::DoNotOptimize(output);
+    });
+}
+
+template <typename Codec, OutputBuffer Output>
+static void BM_DecodeMemory(benchmark::State & state)
+{
+    const auto & expected = memoryInput();
+    const auto & encoded = memoryEncodedInput();
+    const auto size = encoded.size();
+
+    // The input is restored before every iteration, as decoding in place destroys it.
+    // The output of the last call is kept to be verified outside of the timing, every call still allocates its own.
+    std::string input = encoded;
+    std::string output;
+    size_t decoded = 0;
+    const auto decode = [&]
+    {
+        if constexpr (Output == OutputBuffer::InPlace)
+        {
+            decoded = decodeInPlace<Codec>(input.data(), size);
+            benchmark::DoNotOptimize(input);
+        }
+        else
+        {
+            std::string().swap(output);
+            output.resize(Output == OutputBuffer::Exact ? Codec::decodedSize(input.data(), size) : size);
+            decoded = Codec::decode(input.data(), size, output.data());
+            benchmark::DoNotOptimize(output);
+        }
+    };
+    const auto is_valid = [&]
+    {
+        const auto * result = Output == OutputBuffer::InPlace ? input.data() : output.data();
+        return decoded == expected.size() && std::memcmp(result, expected.data(), decoded) == 0;
+    };
+
+    decode();
+    if (!is_valid())
+    {
+        state.SkipWithError("The decoded output differs from the original data");
+        return;
+    }
+
+    const auto output_size = Output == OutputBuffer::InPlace ? 0 : Output == OutputBuffer::Exact ? expected.size() : size;
+    runMemory(state, size, output_size, [&] { std::memcpy(input.data(), encoded.data(), size); }, decode);
+    if (!is_valid())
+        state.SkipWithError("The decoded output differs from the original data");
+}
+
+BENCHMARK_TEMPLATE(BM_EncodeMemory, TurboBase64, OutputBuffer::UpperBound)->Unit(benchmark::kMillisecond)->Name("Turbo-Base64 encode 64MiB 1.5x buffer");
+BENCHMARK_TEMPLATE(BM_EncodeMemory, TurboBase64, OutputBuffer::Exact)->Unit(benchmark::kMillisecond)->Name("Turbo-Base64 encode 64MiB exact buffer");
+BENCHMARK_TEMPLATE(BM_EncodeMemory, AklompBase64, OutputBuffer::UpperBound)->Unit(benchmark::kMillisecond)->Name("aklomp/base64 encode 64MiB 1.5x buffer");
+BENCHMARK_TEMPLATE(BM_EncodeMemory, AklompBase64, OutputBuffer::Exact)->Unit(benchmark::kMillisecond)->Name("aklomp/base64 encode 64MiB exact buffer");
+
+BENCHMARK_TEMPLATE(BM_DecodeMemory, TurboBase64, OutputBuffer::UpperBound)->Unit(benchmark::kMillisecond)->Name("Turbo-Base64 decode 64MiB input-sized buffer");
+BENCHMARK_TEMPLATE(BM_DecodeMemory, TurboBase64, OutputBuffer::Exact)->Unit(benchmark::kMillisecond)->Name("Turbo-Base64 decode 64MiB exact buffer");
+BENCHMARK_TEMPLATE(BM_DecodeMemory, TurboBase64, OutputBuffer::InPlace)->Unit(benchmark::kMillisecond)->Name("Turbo-Base64 decode 64MiB in place");
+BENCHMARK_TEMPLATE(BM_DecodeMemory, AklompBase64, OutputBuffer::UpperBound)->Unit(benchmark::kMillisecond)->Name("aklomp/base64 decode 64MiB input-sized buffer");
+BENCHMARK_TEMPLATE(BM_DecodeMemory, AklompBase64, OutputBuffer::Exact)->Unit(benchmark::kMillisecond)->Name("aklomp/base64 decode 64MiB exact buffer");
+BENCHMARK_TEMPLATE(BM_DecodeMemory, AklompBase64, OutputBuffer::InPlace)->Unit(benchmark::kMillisecond)->Name("aklomp/base64 decode 64MiB in place");
+BENCHMARK_TEMPLATE(BM_DecodeMemory, Avx512VbmiBase64, OutputBuffer::Exact)->Unit(benchmark::kMillisecond)->Name("AVX-512 VBMI decode 64MiB exact buffer");
+BENCHMARK_TEMPLATE(BM_DecodeMemory, Avx512VbmiBase64, OutputBuffer::InPlace)->Unit(benchmark::kMillisecond)->Name("AVX-512 VBMI decode 64MiB in place");
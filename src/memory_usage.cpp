@@ -0,0 +1,60 @@
+#include "memory_usage.h"
+
+#include <fstream>
+#include <string>
+#include <sys/resource.h>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+#if defined(__linux__)
+/// Reads a field of /proc/self/status such as `VmRSS:    1234 kB`.
+static size_t readProcStatus(const std::string & field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.starts_with(field) && line.size() > field.size() && line[field.size()] == ':')
+            return std::stoull(line.substr(field.size() + 1)) * 1024;
+    }
+    return 0;
+}
+#endif
+
+size_t currentMemoryUsage()
+{
+#if defined(__linux__)
+    return readProcStatus("VmRSS");
+#elif defined(__APPLE__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+        return 0;
+    return info.resident_size;
+#else
+    return 0;
+#endif
+}
+
+size_t peakMemoryUsage()
+{
+#if defined(__linux__)
+    return readProcStatus("VmHWM");
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    // ru_maxrss is in bytes on macOS
+    return static_cast<size_t>(usage.ru_maxrss);
+#endif
+}
+
+void resetPeakMemoryUsage()
+{
+#if defined(__linux__)
+    // Writing 5 to clear_refs resets VmHWM to VmRSS.
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+#endif
+}
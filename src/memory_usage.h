@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+
+/// Resident set size of the process in bytes.
+size_t currentMemoryUsage();
+
+/// Peak resident set size of the process in bytes since the start or the last `resetPeakMemoryUsage`.
+size_t peakMemoryUsage();
+
+/// Makes the peak equal to the current resident set size. Only supported on Linux,
+/// elsewhere it does nothing and the peak covers the whole lifetime of the process.
+void resetPeakMemoryUsage();
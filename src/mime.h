@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+/// MIME base64 (RFC 2045): lines of 76 symbols separated by CRLF, no line break after the last line.
+static constexpr size_t mimeLineSymbols = 76;
+static constexpr size_t mimeLineBytes = mimeLineSymbols / 4 * 3;
+
+/// Size of the MIME representation of `size` bytes, line breaks included.
+constexpr size_t mimeEncodedSize(size_t size)
+{
+    const auto symbols = (size + 2) / 3 * 4;
+    return symbols == 0 ? 0 : symbols + (symbols - 1) / mimeLineSymbols * 2;
+}
+
+/// Encodes line by line with `encode` (a padded codec with the conventions of codecs.h), writing CRLF between lines.
+template <typename Encode>
+size_t encodeMimeLines(const char * src, size_t srclen, char * out, Encode && encode)
+{
+    size_t written = 0;
+    for (size_t i = 0; i < srclen; i += mimeLineBytes)
+    {
+        if (i != 0)
+        {
+            out[written++] = '\r';
+            out[written++] = '\n';
+        }
+        written += encode(src + i, std::min(mimeLineBytes, srclen - i), out + written);
+    }
+    return written;
+}
+
+/// Decodes with `decode` (a padded codec with the conventions of codecs.h) skipping CR and LF anywhere in the input,
+/// so lines of any width are accepted. The symbols are gathered into chunks on the stack, a chunk that is followed
+/// by more symbols must not have padding. Returns false on invalid input.
+template <typename Decode>
+bool decodeSkippingLineBreaks(const char * src, size_t srclen, char * out, size_t & outlen, Decode && decode)
+{
+    static constexpr size_t chunk_size = 4096;
+    char chunk[chunk_size];
+    size_t chunk_fill = 0;
+
+    outlen = 0;
+    for (size_t i = 0; i < srclen; ++i)
+    {
+        if (src[i] == '\r' || src[i] == '\n')
+            continue;
+        if (chunk_fill == chunk_size)
+        {
+            if (decode(chunk, chunk_size, out + outlen) != chunk_size / 4 * 3)
+                return false;
+            outlen += chunk_size / 4 * 3;
+            chunk_fill = 0;
+        }
+        chunk[chunk_fill++] = src[i];
+    }
+
+    if (chunk_fill == 0)
+        return true;
+    const auto written = decode(chunk, chunk_fill, out + outlen);
+    outlen += written;
+    return written != 0;
+}
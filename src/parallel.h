@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <string_view>
+
+#include "codecs.h"
+#include "column.h"
+#include "thread_pool.h"
+
+/// Encoding splits the input at a multiple of 3 bytes and decoding at a multiple of 4 symbols,
+/// so every chunk maps to a fixed part of the output and the concatenation is the same as the single-threaded result.
+static constexpr size_t parallelEncodeChunkSize = 3 << 18;
+static constexpr size_t parallelDecodeChunkSize = 4 << 18;
+
+/// Encodes `input` into `out`, which must have room for `base64EncodedSize(input.size())` bytes.
+template <typename Codec>
+size_t parallelEncode(ThreadPool & pool, std::string_view input, char * out)
+{
+    const auto chunks = (input.size() + parallelEncodeChunkSize - 1) / parallelEncodeChunkSize;
+    pool.parallelFor(chunks, [&](size_t chunk)
+    {
+        const auto begin = chunk * parallelEncodeChunkSize;
+        const auto size = std::min(parallelEncodeChunkSize, input.size() - begin);
+        Codec::encode(input.data() + begin, size, out + begin / 3 * 4);
+    });
+    return base64EncodedSize(input.size());
+}
+
+/// Decodes `input` into `out`, which must have room for `base64DecodedSizeUpperBound(input.size())` bytes.
+/// Returns the decoded size, or 0 if some chunk is not valid base64 (padding is only allowed in the last one).
+template <typename Codec>
+size_t parallelDecode(ThreadPool & pool, std::string_view input, char * out)
+{
+    const auto chunks = (input.size() + parallelDecodeChunkSize - 1) / parallelDecodeChunkSize;
+    std::atomic<bool> valid = true;
+    std::atomic<size_t> last_chunk_size = 0;
+    pool.parallelFor(chunks, [&](size_t chunk)
+    {
+        const auto begin = chunk * parallelDecodeChunkSize;
+        const auto size = std::min(parallelDecodeChunkSize, input.size() - begin);
+        const auto written = Codec::decode(input.data() + begin, size, out + begin / 4 * 3);
+        if (written == 0)
+            valid = false;
+        if (chunk + 1 == chunks)
+            last_chunk_size = written;
+    });
+    if (!valid || chunks == 0)
+        return 0;
+    return (chunks - 1) * parallelDecodeChunkSize / 4 * 3 + last_chunk_size;
+}
+
+/// Encodes the rows of `src` into `dst` prepared by `prepareEncodedColumn` in parallel,
+/// every task gets a contiguous range of rows.
+template <typename Codec>
+void parallelEncodeColumn(ThreadPool & pool, const ColumnString & src, ColumnString & dst, size_t rows_per_task)
+{
+    const auto rows = src.size();
+    const auto tasks = (rows + rows_per_task - 1) / rows_per_task;
+    pool.parallelFor(tasks, [&](size_t task)
+    {
+        const auto row_begin = task * rows_per_task;
+        encodeColumnRows<Codec>(src, dst, row_begin, std::min(row_begin + rows_per_task, rows));
+    });
+}
+
+/// Decodes the rows of `src` into `dst` prepared by `prepareDecodedColumn` in parallel,
+/// every task gets a contiguous range of rows. Returns false if some row is not valid base64.
+template <typename Codec>
+bool parallelDecodeColumn(ThreadPool & pool, const ColumnString & src, ColumnString & dst, size_t rows_per_task)
+{
+    const auto rows = src.size();
+    const auto tasks = (rows + rows_per_task - 1) / rows_per_task;
+    std::atomic<bool> valid = true;
+    pool.parallelFor(tasks, [&](size_t task)
+    {
+        const auto row_begin = task * rows_per_task;
+        if (!decodeColumnRows<Codec>(src, dst, row_begin, std::min(row_begin + rows_per_task, rows)))
+            valid = false;
+    });
+    return valid;
+}
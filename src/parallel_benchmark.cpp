@@ -0,0 +1,179 @@
+#include <chrono>
+#include <limits>
+#include <string>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "codecs.h"
+#include "column.h"
+#include "initializer.h"
+#include "parallel.h"
+#include "thread_pool.h"
+
+/// Parallel benchmarks split a large input between the threads of a pool, the argument is the number of threads.
+/// Besides the throughput they report `speedup` and `efficiency` (speedup divided by the number of threads)
+/// relative to a single-threaded call of the codec on the whole input, and check that the output is the same.
+static constexpr size_t parallelInputSize = 64 << 20;
+static constexpr size_t parallelColumnRows = 1 << 20;
+static constexpr size_t parallelColumnRowsPerTask = 1 << 12;
+
+static std::string makeLargeInput()
+{
+    std::string input;
+    input.reserve(parallelInputSize);
+    for (size_t i = 0; input.size() < parallelInputSize; ++i)
+        input.append(Initializer::stringsToEncode[i % Initializer::stringsToEncode.size()]);
+    input.resize(parallelInputSize);
+    return input;
+}
+
+template <typename Function>
+static double bestOfThreeSeconds(Function && function)
+{
+    double best = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const auto finish = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(finish - start).count());
+    }
+    return best;
+}
+
+/// Runs `function` in the benchmark loop and reports its scaling relative to `single_thread_seconds`.
+template <typename Function>
+static void runScaling(benchmark::State & state, double single_thread_seconds, size_t bytes, Function && function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        function();
+        benchmark::ClobberMemory();
+    }
+    const auto finish = std::chrono::steady_clock::now();
+
+    const auto seconds = std::chrono::duration<double>(finish - start).count() / static_cast<double>(state.iterations());
+    const auto speedup = single_thread_seconds / seconds;
+    state.counters["speedup"] = speedup;
+    state.counters["efficiency"] = speedup / static_cast<double>(state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+
+template <typename Codec>
+static void BM_ParallelEncode(benchmark::State & state)
+{
+    const auto input = makeLargeInput();
+    std::string expected(base64EncodedSize(input.size()), '\0');
+    const auto single_thread_seconds = bestOfThreeSeconds([&] { Codec::encode(input.data(), input.size(), expected.data()); });
+
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    std::string output(expected.size(), '\0');
+    parallelEncode<Codec>(pool, input, output.data());
+    if (output != expected)
+    {
+        state.SkipWithError("Parallel encoding differs from the single-threaded one");
+        return;
+    }
+
+    runScaling(state, single_thread_seconds, input.size(), [&] { parallelEncode<Codec>(pool, input, output.data()); });
+}
+
+template <typename Codec>
+static void BM_ParallelDecode(benchmark::State & state)
+{
+    const auto decoded = makeLargeInput();
+    std::string input(base64EncodedSize(decoded.size()), '\0');
+    Codec::encode(decoded.data(), decoded.size(), input.data());
+
+    std::string expected(base64DecodedSizeUpperBound(input.size()), '\0');
+    size_t expected_size = 0;
+    const auto single_thread_seconds
+        = bestOfThreeSeconds([&] { expected_size = Codec::decode(input.data(), input.size(), expected.data()); });
+    expected.resize(expected_size);
+
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    std::string output(base64DecodedSizeUpperBound(input.size()), '\0');
+    output.resize(parallelDecode<Codec>(pool, input, output.data()));
+    if (output != expected || output != decoded)
+    {
+        state.SkipWithError("Parallel decoding differs from the single-threaded one");
+        return;
+    }
+
+    runScaling(state, single_thread_seconds, input.size(), [&] { parallelDecode<Codec>(pool, input, output.data()); });
+}
+
+template <typename Codec>
+static void BM_ParallelEncodeColumn(benchmark::State & state)
+{
+    ColumnString input;
+    input.offsets.reserve(parallelColumnRows);
+    for (size_t row = 0; row < parallelColumnRows; ++row)
+        input.insert(Initializer::stringsToEncode[row % Initializer::stringsToEncode.size()]);
+
+    ColumnString expected;
+    prepareEncodedColumn(input, expected);
+    const auto single_thread_seconds = bestOfThreeSeconds([&] { encodeColumnRows<Codec>(input, expected, 0, input.size()); });
+
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    ColumnString output;
+    prepareEncodedColumn(input, output);
+    parallelEncodeColumn<Codec>(pool, input, output, parallelColumnRowsPerTask);
+    if (output.chars != expected.chars || output.offsets != expected.offsets)
+    {
+        state.SkipWithError("Parallel encoding differs from the single-threaded one");
+        return;
+    }
+
+    runScaling(state, single_thread_seconds, input.offsets.back(),
+               [&] { parallelEncodeColumn<Codec>(pool, input, output, parallelColumnRowsPerTask); });
+}
+
+template <typename Codec>
+static void BM_ParallelDecodeColumn(benchmark::State & state)
+{
+    ColumnString raw;
+    raw.offsets.reserve(parallelColumnRows);
+    for (size_t row = 0; row < parallelColumnRows; ++row)
+        raw.insert(Initializer::stringsToEncode[row % Initializer::stringsToEncode.size()]);
+    ColumnString input;
+    encodeColumn<Codec>(raw, input);
+
+    ColumnString expected;
+    prepareDecodedColumn(input, expected);
+    const auto single_thread_seconds = bestOfThreeSeconds([&] { decodeColumnRows<Codec>(input, expected, 0, input.size()); });
+
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    ColumnString output;
+    prepareDecodedColumn(input, output);
+    if (!parallelDecodeColumn<Codec>(pool, input, output, parallelColumnRowsPerTask)
+        || output.chars != expected.chars || output.offsets != expected.offsets || output.chars != raw.chars)
+    {
+        state.SkipWithError("Parallel decoding differs from the single-threaded one");
+        return;
+    }
+
+    runScaling(state, single_thread_seconds, input.offsets.back(),
+               [&] { parallelDecodeColumn<Codec>(pool, input, output, parallelColumnRowsPerTask); });
+}
+
+/// 1, 2, 4, ... threads up to the number of hardware threads, which is always included.
+static void threadCounts(benchmark::internal::Benchmark * benchmark)
+{
+    const auto hardware_threads = static_cast<int64_t>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int64_t threads = 1; threads < hardware_threads; threads *= 2)
+        benchmark->Arg(threads);
+    benchmark->Arg(hardware_threads);
+    benchmark->ArgName("threads")->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(BM_ParallelEncode, TurboBase64)->Apply(threadCounts)->Name("Turbo-Base64 parallel encode 64MiB");
+BENCHMARK_TEMPLATE(BM_ParallelEncode, AklompBase64)->Apply(threadCounts)->Name("aklomp/base64 parallel encode 64MiB");
+BENCHMARK_TEMPLATE(BM_ParallelDecode, TurboBase64)->Apply(threadCounts)->Name("Turbo-Base64 parallel decode 64MiB");
+BENCHMARK_TEMPLATE(BM_ParallelDecode, AklompBase64)->Apply(threadCounts)->Name("aklomp/base64 parallel decode 64MiB");
+BENCHMARK_TEMPLATE(BM_ParallelEncodeColumn, TurboBase64)->Apply(threadCounts)->Name("Turbo-Base64 parallel encode column 1M rows");
+BENCHMARK_TEMPLATE(BM_ParallelEncodeColumn, AklompBase64)->Apply(threadCounts)->Name("aklomp/base64 parallel encode column 1M rows");
+BENCHMARK_TEMPLATE(BM_ParallelDecodeColumn, TurboBase64)->Apply(threadCounts)->Name("Turbo-Base64 parallel decode column 1M rows");
+BENCHMARK_TEMPLATE(BM_ParallelDecodeColumn, AklompBase64)->Apply(threadCounts)->Name("aklomp/base64 parallel decode column 1M rows");
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "perf_events.h"
+
+/// Hardware counters of a benchmark as user counters: every event per iteration, plus `cycles_per_byte`
+/// and `uops_per_byte` for benchmarks that report the bytes processed. Counting starts at construction,
+/// so it should be created right before the benchmark loop, and `report` called after `SetBytesProcessed`.
+/// Only the thread that runs the benchmark is counted. When the counters are not available,
+/// nothing is reported and the reason is printed once.
+class PerfCounters
+{
+public:
+    PerfCounters()
+    {
+        static bool warned = false;
+        if (!events.available() && !warned)
+        {
+            std::cerr << "Hardware performance counters are not reported: " << events.error() << std::endl;
+            warned = true;
+        }
+        events.start();
+    }
+
+    void report(benchmark::State & state)
+    {
+        events.stop();
+        if (!events.available() || state.iterations() == 0)
+            return;
+
+        for (size_t i = 0; i < perfEventCount; ++i)
+        {
+            const auto event = static_cast<PerfEvent>(i);
+            if (events.has(event))
+                state.counters[std::string(toString(event))] = benchmark::Counter(static_cast<double>(events.value(event)), benchmark::Counter::kAvgIterations);
+        }
+
+        const auto bytes = state.counters.find("bytes_per_second");
+        if (bytes == state.counters.end() || bytes->second.value == 0)
+            return;
+        if (events.has(PerfEvent::Cycles))
+            state.counters["cycles_per_byte"] = static_cast<double>(events.value(PerfEvent::Cycles)) / bytes->second.value;
+        if (events.has(PerfEvent::Uops))
+            state.counters["uops_per_byte"] = static_cast<double>(events.value(PerfEvent::Uops)) / bytes->second.value;
+    }
+
+private:
+    PerfEvents events;
+};
@@ -0,0 +1,181 @@
+#include "perf_events.h"
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+std::string_view toString(PerfEvent event)
+{
+    switch (event)
+    {
+        case PerfEvent::Cycles:
+            return "cycles";
+        case PerfEvent::Instructions:
+            return "instructions";
+        case PerfEvent::BranchMisses:
+            return "branch_misses";
+        case PerfEvent::L1DMisses:
+            return "l1d_misses";
+        case PerfEvent::Uops:
+            return "uops";
+    }
+    return "unknown";
+}
+
+#if defined(__linux__)
+
+namespace
+{
+
+/// Returns false if the event is not known on this CPU.
+bool eventAttributes(PerfEvent event, perf_event_attr & attr)
+{
+    switch (event)
+    {
+        case PerfEvent::Cycles:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            return true;
+        case PerfEvent::Instructions:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            return true;
+        case PerfEvent::BranchMisses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            return true;
+        case PerfEvent::L1DMisses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            return true;
+        case PerfEvent::Uops:
+        {
+#if defined(__x86_64__)
+            unsigned eax = 0;
+            unsigned vendor[3] = {};
+            if (!__get_cpuid(0, &eax, &vendor[0], &vendor[2], &vendor[1]))
+                return false;
+            attr.type = PERF_TYPE_RAW;
+            if (std::memcmp(vendor, "GenuineIntel", 12) == 0)
+            {
+                attr.config = 0x010e;
+                return true;
+            }
+            if (std::memcmp(vendor, "AuthenticAMD", 12) == 0)
+            {
+                attr.config = 0x00c1;
+                return true;
+            }
+#endif
+            return false;
+        }
+    }
+    return false;
+}
+
+int openEvent(PerfEvent event, int group_fd)
+{
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    if (!eventAttributes(event, attr))
+        return -1;
+    attr.disabled = group_fd < 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+}
+
+PerfEvents::PerfEvents()
+{
+    for (auto & fd : fds)
+        fd = -1;
+
+    for (size_t i = 0; i < perfEventCount; ++i)
+    {
+        const auto fd = openEvent(static_cast<PerfEvent>(i), leader);
+        if (fd < 0)
+        {
+            if (leader < 0 && open_error.empty())
+                open_error = std::string("perf_event_open: ") + std::strerror(errno);
+            continue;
+        }
+        if (leader < 0)
+            leader = fd;
+        fds[i] = fd;
+        positions[i] = opened++;
+    }
+    if (leader >= 0)
+        open_error.clear();
+}
+
+PerfEvents::~PerfEvents()
+{
+    for (const auto fd : fds)
+        if (fd >= 0)
+            ::close(fd);
+}
+
+void PerfEvents::start()
+{
+    if (leader < 0)
+        return;
+    ::ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void PerfEvents::stop()
+{
+    if (leader < 0)
+        return;
+    ::ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // nr, time_enabled, time_running, then a value per event.
+    uint64_t data[3 + perfEventCount] = {};
+    if (::read(leader, data, sizeof(data)) < static_cast<ssize_t>(3 * sizeof(uint64_t)))
+        return;
+    const auto time_enabled = data[1];
+    const auto time_running = data[2];
+    for (size_t i = 0; i < perfEventCount; ++i)
+    {
+        if (fds[i] < 0)
+            continue;
+        const auto value = data[3 + positions[i]];
+        values[i] = time_running == 0 || time_running == time_enabled
+            ? value
+            : static_cast<uint64_t>(static_cast<double>(value) * static_cast<double>(time_enabled) / static_cast<double>(time_running));
+    }
+}
+
+#else
+
+PerfEvents::PerfEvents()
+    : open_error("perf_event_open is only available on Linux")
+{
+    for (auto & fd : fds)
+        fd = -1;
+}
+
+PerfEvents::~PerfEvents() = default;
+
+void PerfEvents::start()
+{
+}
+
+void PerfEvents::stop()
+{
+}
+
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/// Hardware events counted with perf_event_open.
+enum class PerfEvent
+{
+    Cycles,
+    Instructions,
+    BranchMisses,
+    L1DMisses,
+    /// A raw event, only known for Intel (UOPS_ISSUED.ANY) and AMD (retired ops) CPUs.
+    Uops,
+};
+
+static constexpr size_t perfEventCount = 5;
+
+std::string_view toString(PerfEvent event);
+
+/// A group of hardware counters of the calling thread in user space, scheduled together so that they cover
+/// the same instructions. Events that cannot be opened (unsupported by the CPU, a virtual machine without a PMU,
+/// perf_event_paranoid, not Linux) are left out, `error` says why the group could not be opened at all.
+class PerfEvents
+{
+public:
+    PerfEvents();
+    ~PerfEvents();
+
+    PerfEvents(const PerfEvents &) = delete;
+    PerfEvents & operator=(const PerfEvents &) = delete;
+
+    bool available() const { return leader >= 0; }
+    const std::string & error() const { return open_error; }
+
+    bool has(PerfEvent event) const { return fds[static_cast<size_t>(event)] >= 0; }
+
+    /// Resets and starts the counters.
+    void start();
+
+    /// Stops the counters and reads them, scaled up if the group was only scheduled for a part of the time.
+    void stop();
+
+    /// The value between the last `start` and `stop`.
+    uint64_t value(PerfEvent event) const { return values[static_cast<size_t>(event)]; }
+
+private:
+    int leader = -1;
+    int fds[perfEventCount];
+    /// Position of every event in the group read, in the order of opening.
+    size_t positions[perfEventCount];
+    size_t opened = 0;
+    uint64_t values[perfEventCount] = {};
+    std::string open_error;
+};
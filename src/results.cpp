@@ -0,0 +1,189 @@
+#include "results.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "json.h"
+
+namespace
+{
+
+std::string hostName()
+{
+    char name[256] = {};
+    if (::gethostname(name, sizeof(name) - 1) != 0 || name[0] == '\0')
+        return "unknown";
+    return name;
+}
+
+double toNanoseconds(double time, const std::string & unit)
+{
+    if (unit == "us")
+        return time * 1e3;
+    if (unit == "ms")
+        return time * 1e6;
+    if (unit == "s")
+        return time * 1e9;
+    return time;
+}
+
+std::string stringMember(const JsonValue & value, std::string_view key)
+{
+    const auto * member = value.find(key);
+    return member != nullptr && member->type == JsonValue::String ? member->string : std::string();
+}
+
+}
+
+std::string newResultsPath(const std::string & directory)
+{
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+        throw std::runtime_error("Cannot create results store " + directory + ": " + error.message());
+
+    const auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm time{};
+    ::localtime_r(&now, &time);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y%m%d-%H%M%S", &time);
+    const auto prefix = std::string(date) + "-" + hostName();
+
+    // The file is created here, so that another run that starts in the same second gets the next suffix.
+    for (size_t attempt = 1;; ++attempt)
+    {
+        const auto name = prefix + (attempt == 1 ? "" : "-" + std::to_string(attempt)) + ".json";
+        const auto path = (std::filesystem::path(directory) / name).string();
+        const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+        if (fd >= 0)
+        {
+            ::close(fd);
+            return path;
+        }
+        if (errno != EEXIST)
+            throw std::runtime_error("Cannot create " + path + ": " + std::strerror(errno));
+    }
+}
+
+BenchmarkRun readBenchmarkRun(const std::string & path)
+{
+    std::ifstream file(path);
+    if (!file)
+        throw std::runtime_error("Cannot open " + path);
+    std::stringstream text;
+    text << file.rdbuf();
+    const auto document = parseJson(text.str());
+
+    BenchmarkRun run;
+    if (const auto * context = document.find("context"); context != nullptr)
+        for (const auto & [key, value] : context->object)
+            if (value.type == JsonValue::String)
+                run.context.emplace_back(key, value.string);
+
+    const auto * benchmarks = document.find("benchmarks");
+    if (benchmarks == nullptr || benchmarks->type != JsonValue::Array)
+        throw std::runtime_error(path + " is not the output of the JSON reporter: no \"benchmarks\"");
+
+    std::map<std::string, size_t> positions;
+    for (const auto & benchmark : benchmarks->array)
+    {
+        if (stringMember(benchmark, "run_type") == "aggregate")
+            continue;
+        if (const auto * error = benchmark.find("error_occurred"); error != nullptr && error->boolean)
+            continue;
+
+        // The name of a repetition has a suffix, run_name is the same for all of them.
+        auto name = stringMember(benchmark, "run_name");
+        if (name.empty())
+            name = stringMember(benchmark, "name");
+
+        BenchmarkSamples samples;
+        samples.name = name;
+        double value = 0;
+        if (const auto * bytes_per_second = benchmark.find("bytes_per_second"); bytes_per_second != nullptr)
+        {
+            samples.metric = "bytes_per_second";
+            samples.higher_is_better = true;
+            value = bytes_per_second->number;
+        }
+        else if (const auto * cpu_time = benchmark.find("cpu_time"); cpu_time != nullptr)
+        {
+            samples.metric = "cpu_time";
+            value = toNanoseconds(cpu_time->number, stringMember(benchmark, "time_unit"));
+        }
+        else
+            continue;
+
+        const auto [it, inserted] = positions.try_emplace(name, run.benchmarks.size());
+        if (inserted)
+            run.benchmarks.push_back(std::move(samples));
+        run.benchmarks[it->second].values.push_back(value);
+    }
+    return run;
+}
+
+double median(std::vector<double> values)
+{
+    if (values.empty())
+        return 0;
+    const auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    if (values.size() % 2 == 1)
+        return *middle;
+    return (*middle + *std::max_element(values.begin(), middle)) / 2;
+}
+
+double medianAbsoluteDeviation(const std::vector<double> & values)
+{
+    const auto center = median(values);
+    std::vector<double> deviations;
+    deviations.reserve(values.size());
+    for (const auto value : values)
+        deviations.push_back(std::abs(value - center));
+    return median(std::move(deviations));
+}
+
+std::vector<BenchmarkComparison> compareRuns(const BenchmarkRun & baseline, const BenchmarkRun & current)
+{
+    std::map<std::string, const BenchmarkSamples *> baseline_benchmarks;
+    for (const auto & samples : baseline.benchmarks)
+        baseline_benchmarks[samples.name] = &samples;
+
+    std::vector<BenchmarkComparison> result;
+    for (const auto & samples : current.benchmarks)
+    {
+        const auto it = baseline_benchmarks.find(samples.name);
+        if (it == baseline_benchmarks.end() || it->second->metric != samples.metric)
+            continue;
+        const auto & before = *it->second;
+
+        BenchmarkComparison comparison{
+            .name = samples.name,
+            .metric = samples.metric,
+            .baseline_median = median(before.values),
+            .baseline_mad = medianAbsoluteDeviation(before.values),
+            .baseline_repetitions = before.values.size(),
+            .current_median = median(samples.values),
+            .current_mad = medianAbsoluteDeviation(samples.values),
+            .current_repetitions = samples.values.size(),
+        };
+        if (comparison.baseline_median > 0 && comparison.current_median > 0)
+            comparison.slowdown = samples.higher_is_better ? comparison.baseline_median / comparison.current_median - 1
+                                                           : comparison.current_median / comparison.baseline_median - 1;
+        comparison.significant = std::abs(comparison.current_median - comparison.baseline_median)
+            > significanceFactor * (comparison.baseline_mad + comparison.current_mad);
+        result.push_back(std::move(comparison));
+    }
+    return result;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/// The results store: `base64-benchmark --results_store=DIR` writes every run with Google Benchmark's JSON reporter
+/// to a new file in DIR, with the machine fingerprint (see fingerprint.h) in its "context".
+/// `base64-benchmark-compare` reads two such files back and reports the benchmarks that became slower.
+
+/// A new empty file in `directory` (created if needed) for the results of a run that starts now:
+/// `<date>-<time>-<host>.json`, so that the files of a machine sort chronologically, with a `-2`, `-3`, ... suffix
+/// for the runs that start in the same second. Throws std::runtime_error if the file cannot be created.
+std::string newResultsPath(const std::string & directory);
+
+/// All the repetitions of one benchmark in a run.
+struct BenchmarkSamples
+{
+    std::string name;
+    /// "bytes_per_second" when the benchmark reports it, otherwise "cpu_time" in nanoseconds.
+    std::string metric;
+    bool higher_is_better = false;
+    std::vector<double> values;
+};
+
+struct BenchmarkRun
+{
+    /// The string entries of the context: the fingerprint, the date, the host and so on.
+    std::vector<std::pair<std::string, std::string>> context;
+    /// In the order of the run. Aggregates (mean, median, stddev) and failed runs are skipped.
+    std::vector<BenchmarkSamples> benchmarks;
+};
+
+/// Reads a file written by the JSON reporter. Throws std::runtime_error on I/O errors and invalid files.
+BenchmarkRun readBenchmarkRun(const std::string & path);
+
+double median(std::vector<double> values);
+
+/// Median absolute deviation from the median, a measure of the noise that ignores outliers.
+double medianAbsoluteDeviation(const std::vector<double> & values);
+
+/// The difference of the medians of a benchmark between the baseline and the current run.
+/// It is significant when it exceeds `significanceFactor` times the sum of the MADs of both runs,
+/// so with a single repetition on both sides every difference is significant.
+static constexpr double significanceFactor = 3;
+
+struct BenchmarkComparison
+{
+    std::string name;
+    std::string metric;
+    double baseline_median = 0;
+    double baseline_mad = 0;
+    size_t baseline_repetitions = 0;
+    double current_median = 0;
+    double current_mad = 0;
+    size_t current_repetitions = 0;
+    /// Relative slowdown of the current run: 0.1 is 10% slower, -0.1 is 10% faster.
+    double slowdown = 0;
+    bool significant = false;
+};
+
+/// Compares the benchmarks that are present in both runs with the same metric, in the order of the current run.
+std::vector<BenchmarkComparison> compareRuns(const BenchmarkRun & baseline, const BenchmarkRun & current);
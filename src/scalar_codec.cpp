@@ -0,0 +1,205 @@
+#include "scalar_codec.h"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "mime.h"
+
+const char base64Alphabet[64] = {
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+    'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
+    'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+    'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/',
+};
+
+const char base64UrlAlphabet[64] = {
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+    'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
+    'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+    'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '-', '_',
+};
+
+namespace
+{
+
+constexpr uint8_t invalid = 0xFF;
+
+/// Symbol to its 6-bit value, `invalid` for everything else including '='.
+/// Every valid value fits in 6 bits, so a set bit 6 or 7 in a combination of values means an invalid symbol.
+constexpr std::array<uint8_t, 256> makeDecodeTable(std::string_view alphabet)
+{
+    std::array<uint8_t, 256> table{};
+    table.fill(invalid);
+    for (size_t i = 0; i < alphabet.size(); ++i)
+        table[static_cast<uint8_t>(alphabet[i])] = static_cast<uint8_t>(i);
+    return table;
+}
+
+constexpr auto decodeTable = makeDecodeTable("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
+constexpr auto urlDecodeTable = makeDecodeTable("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_");
+
+uint8_t decodeSymbol(char symbol)
+{
+    return decodeTable[static_cast<uint8_t>(symbol)];
+}
+
+uint8_t decodeUrlSymbol(char symbol)
+{
+    return urlDecodeTable[static_cast<uint8_t>(symbol)];
+}
+
+/// Full 3-byte groups to 4 symbols each, returns the number of bytes consumed.
+size_t encodeGroups(const uint8_t * in, size_t srclen, char *& out, const char * alphabet)
+{
+    size_t i = 0;
+    for (; i + 3 <= srclen; i += 3)
+    {
+        const uint32_t value = (uint32_t{in[i]} << 16) | (uint32_t{in[i + 1]} << 8) | in[i + 2];
+        *out++ = alphabet[value >> 18];
+        *out++ = alphabet[(value >> 12) & 0x3F];
+        *out++ = alphabet[(value >> 6) & 0x3F];
+        *out++ = alphabet[value & 0x3F];
+    }
+    return i;
+}
+
+}
+
+size_t scalarEncode(const char * src, size_t srclen, char * out)
+{
+    const auto * in = reinterpret_cast<const uint8_t *>(src);
+    char * const out_begin = out;
+    const auto i = encodeGroups(in, srclen, out, base64Alphabet);
+
+    const auto rest = srclen - i;
+    if (rest != 0)
+    {
+        const uint32_t value = (uint32_t{in[i]} << 16) | (rest == 2 ? uint32_t{in[i + 1]} << 8 : 0);
+        *out++ = base64Alphabet[value >> 18];
+        *out++ = base64Alphabet[(value >> 12) & 0x3F];
+        *out++ = rest == 2 ? base64Alphabet[(value >> 6) & 0x3F] : '=';
+        *out++ = '=';
+    }
+    return static_cast<size_t>(out - out_begin);
+}
+
+size_t scalarDecode(const char * src, size_t srclen, char * out)
+{
+    if (srclen == 0 || srclen % 4 != 0)
+        return 0;
+
+    auto * dst = reinterpret_cast<uint8_t *>(out);
+    uint8_t * const dst_begin = dst;
+
+    // The last quadruple may have padding, so it is decoded separately.
+    const auto body = srclen - 4;
+    for (size_t i = 0; i < body; i += 4)
+    {
+        const auto a = decodeSymbol(src[i]);
+        const auto b = decodeSymbol(src[i + 1]);
+        const auto c = decodeSymbol(src[i + 2]);
+        const auto d = decodeSymbol(src[i + 3]);
+        if (((a | b | c | d) & 0xC0) != 0)
+            return 0;
+        const uint32_t value = (uint32_t{a} << 18) | (uint32_t{b} << 12) | (uint32_t{c} << 6) | d;
+        *dst++ = static_cast<uint8_t>(value >> 16);
+        *dst++ = static_cast<uint8_t>(value >> 8);
+        *dst++ = static_cast<uint8_t>(value);
+    }
+
+    const char * tail = src + body;
+    const auto padding = (tail[3] == '=') + (tail[3] == '=' && tail[2] == '=');
+    const auto a = decodeSymbol(tail[0]);
+    const auto b = decodeSymbol(tail[1]);
+    const auto c = padding >= 2 ? uint8_t{0} : decodeSymbol(tail[2]);
+    const auto d = padding >= 1 ? uint8_t{0} : decodeSymbol(tail[3]);
+    if (((a | b | c | d) & 0xC0) != 0)
+        return 0;
+    const uint32_t value = (uint32_t{a} << 18) | (uint32_t{b} << 12) | (uint32_t{c} << 6) | d;
+    *dst++ = static_cast<uint8_t>(value >> 16);
+    if (padding < 2)
+        *dst++ = static_cast<uint8_t>(value >> 8);
+    if (padding < 1)
+        *dst++ = static_cast<uint8_t>(value);
+    return static_cast<size_t>(dst - dst_begin);
+}
+
+size_t scalarFindInvalid(const char * src, size_t srclen)
+{
+    for (size_t i = 0; i < srclen; ++i)
+        if (decodeSymbol(src[i]) == invalid)
+            return i;
+    return srclen;
+}
+
+size_t scalarEncodeUrl(const char * src, size_t srclen, char * out)
+{
+    const auto * in = reinterpret_cast<const uint8_t *>(src);
+    char * const out_begin = out;
+    const auto i = encodeGroups(in, srclen, out, base64UrlAlphabet);
+
+    const auto rest = srclen - i;
+    if (rest != 0)
+    {
+        const uint32_t value = (uint32_t{in[i]} << 16) | (rest == 2 ? uint32_t{in[i + 1]} << 8 : 0);
+        *out++ = base64UrlAlphabet[value >> 18];
+        *out++ = base64UrlAlphabet[(value >> 12) & 0x3F];
+        if (rest == 2)
+            *out++ = base64UrlAlphabet[(value >> 6) & 0x3F];
+    }
+    return static_cast<size_t>(out - out_begin);
+}
+
+size_t scalarDecodeUrl(const char * src, size_t srclen, char * out)
+{
+    if (srclen == 0 || srclen % 4 == 1)
+        return 0;
+
+    auto * dst = reinterpret_cast<uint8_t *>(out);
+    uint8_t * const dst_begin = dst;
+
+    size_t i = 0;
+    for (; i + 4 <= srclen; i += 4)
+    {
+        const auto a = decodeUrlSymbol(src[i]);
+        const auto b = decodeUrlSymbol(src[i + 1]);
+        const auto c = decodeUrlSymbol(src[i + 2]);
+        const auto d = decodeUrlSymbol(src[i + 3]);
+        if (((a | b | c | d) & 0xC0) != 0)
+            return 0;
+        const uint32_t value = (uint32_t{a} << 18) | (uint32_t{b} << 12) | (uint32_t{c} << 6) | d;
+        *dst++ = static_cast<uint8_t>(value >> 16);
+        *dst++ = static_cast<uint8_t>(value >> 8);
+        *dst++ = static_cast<uint8_t>(value);
+    }
+
+    // 2 or 3 symbols without padding.
+    const auto rest = srclen - i;
+    if (rest != 0)
+    {
+        const auto a = decodeUrlSymbol(src[i]);
+        const auto b = decodeUrlSymbol(src[i + 1]);
+        const auto c = rest == 3 ? decodeUrlSymbol(src[i + 2]) : uint8_t{0};
+        if (((a | b | c) & 0xC0) != 0)
+            return 0;
+        const uint32_t value = (uint32_t{a} << 18) | (uint32_t{b} << 12) | (uint32_t{c} << 6);
+        *dst++ = static_cast<uint8_t>(value >> 16);
+        if (rest == 3)
+            *dst++ = static_cast<uint8_t>(value >> 8);
+    }
+    return static_cast<size_t>(dst - dst_begin);
+}
+
+size_t scalarEncodeMime(const char * src, size_t srclen, char * out)
+{
+    return encodeMimeLines(src, srclen, out, scalarEncode);
+}
+
+size_t scalarDecodeMime(const char * src, size_t srclen, char * out)
+{
+    size_t outlen = 0;
+    if (!decodeSkippingLineBreaks(src, srclen, out, outlen, scalarDecode))
+        return 0;
+    return outlen;
+}
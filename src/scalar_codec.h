@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+/// A plain table-driven base64 codec with the conventions of codecs.h: padded output,
+/// decoding requires padding and returns 0 on invalid input. Used for the tails of the SIMD kernels.
+size_t scalarEncode(const char * src, size_t srclen, char * out);
+size_t scalarDecode(const char * src, size_t srclen, char * out);
+
+/// base64url (RFC 4648, section 5): '-' and '_' instead of '+' and '/', no padding.
+/// Decoding rejects padding and a single symbol after the last quadruple.
+size_t scalarEncodeUrl(const char * src, size_t srclen, char * out);
+size_t scalarDecodeUrl(const char * src, size_t srclen, char * out);
+
+/// MIME base64, see mime.h. Decoding skips CR and LF anywhere in the input.
+size_t scalarEncodeMime(const char * src, size_t srclen, char * out);
+size_t scalarDecodeMime(const char * src, size_t srclen, char * out);
+
+/// Offset of the first byte of `src` that is not in the alphabet ('=' included), `srclen` if there is none.
+size_t scalarFindInvalid(const char * src, size_t srclen);
+
+/// The standard and the URL and filename safe base64 alphabets.
+extern const char base64Alphabet[64];
+extern const char base64UrlAlphabet[64];
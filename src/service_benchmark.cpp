@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <chrono>
+#include <latch>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "codecs.h"
+#include "encode_service.h"
+#include "initializer.h"
+
+/// Load generator for `EncodeService`: `concurrency` clients are coroutines that send ~50 byte requests
+/// (the inputs of the ~50 symbols size class) one after another, each one as soon as the previous one is encoded.
+/// Reports the throughput and the p50/p99 latency of a request, from the submission to the resumption of the client,
+/// and the mean number of requests in a batch. `delay_us` is how long the executor waits for a batch to fill.
+/// `coalesced` encodes every batch in one pass, `per request` encodes the same batches with one call per request.
+static constexpr size_t serviceRequestsPerIteration = 1 << 14;
+static constexpr size_t serviceMaxBatchBytes = 64 << 10;
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Codec>
+static DetachedTask runClient(EncodeService<Codec> & service, size_t client, size_t requests, std::vector<double> & latencies, std::latch & done)
+{
+    for (size_t i = 0; i < requests; ++i)
+    {
+        const auto input = Initializer::stringsToEncode[(client + i) % 3];
+        const auto start = Clock::now();
+        const auto encoded = co_await service.encode(input);
+        latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        benchmark::DoNotOptimize(encoded.data());
+    }
+    done.count_down();
+}
+
+static double percentile(std::vector<double> & values, double fraction)
+{
+    if (values.empty())
+        return 0;
+    const auto position = values.begin() + static_cast<ptrdiff_t>(fraction * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), position, values.end());
+    return *position;
+}
+
+template <typename Codec>
+static void BM_EncodeService(benchmark::State & state, bool coalesce)
+{
+    const auto concurrency = static_cast<size_t>(state.range(0));
+    const auto requests_per_client = std::max<size_t>(serviceRequestsPerIteration / concurrency, 1);
+    EncodeService<Codec> service(std::chrono::microseconds(state.range(1)), serviceMaxBatchBytes, coalesce);
+
+    // The clients do not check their results, so the output of the service is checked once upfront for every input.
+    for (size_t idx = 0; idx < 3; ++idx)
+    {
+        const auto input = Initializer::stringsToEncode[idx];
+        std::string result;
+        std::latch done(1);
+        [](EncodeService<Codec> & service_, std::string_view input_, std::string & result_, std::latch & done_) -> DetachedTask
+        {
+            result_ = co_await service_.encode(input_);
+            done_.count_down();
+        }(service, input, result, done);
+        done.wait();
+        std::string expected(base64EncodedSize(input.size()), '\0');
+        Codec::encode(input.data(), input.size(), expected.data());
+        if (result != expected)
+        {
+            state.SkipWithError("The output of the service differs from the codec");
+            return;
+        }
+    }
+    const auto warmup = service.statistics();
+
+    std::vector<std::vector<double>> latencies(concurrency);
+    size_t bytes = 0;
+    for (size_t client = 0; client < concurrency; ++client)
+        for (size_t i = 0; i < requests_per_client; ++i)
+            bytes += Initializer::stringsToEncode[(client + i) % 3].size();
+
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        std::latch done(static_cast<ptrdiff_t>(concurrency));
+        for (size_t client = 0; client < concurrency; ++client)
+            runClient(service, client, requests_per_client, latencies[client], done);
+        done.wait();
+    }
+
+    std::vector<double> all_latencies;
+    for (const auto & client_latencies : latencies)
+        all_latencies.insert(all_latencies.end(), client_latencies.begin(), client_latencies.end());
+    const auto statistics = service.statistics();
+    const auto batches = statistics.batches - warmup.batches;
+    const auto requests = statistics.requests - warmup.requests;
+
+    state.counters["p50_us"] = percentile(all_latencies, 0.5);
+    state.counters["p99_us"] = percentile(all_latencies, 0.99);
+    state.counters["batch_requests"] = batches == 0 ? 0 : static_cast<double>(requests) / static_cast<double>(batches);
+    state.counters["requests_per_second"]
+        = benchmark::Counter(static_cast<double>(requests_per_client * concurrency * state.iterations()), benchmark::Counter::kIsRate);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+
+template <typename Codec>
+static void registerServiceBenchmarks()
+{
+    const auto name = std::string(Codec::name) + " service encode";
+    for (const bool coalesce : {true, false})
+    {
+        benchmark::RegisterBenchmark((name + (coalesce ? " coalesced" : " per request")).c_str(), BM_EncodeService<Codec>, coalesce)
+            ->ArgNames({"concurrency", "delay_us"})
+            ->ArgsProduct({{1, 16, 128, 1024}, {0, 20}})
+            ->UseRealTime()
+            ->Unit(benchmark::kMillisecond);
+    }
+}
+
+static bool registerAllServiceBenchmarks()
+{
+    registerServiceBenchmarks<TurboBase64>();
+    registerServiceBenchmarks<AklompBase64>();
+    return true;
+}
+
+[[maybe_unused]] static const bool serviceBenchmarksRegistered = registerAllServiceBenchmarks();
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+
+#include "codecs.h"
+
+/// Streaming encoder for codecs that only have a one-shot API: the input is split at a multiple of 3 bytes,
+/// up to 2 trailing bytes are carried over to the next call, so the output is the same as for a one-shot encode.
+/// `update` needs room for `base64EncodedSize(size + 2)` bytes in `out`, `finish` for 4 bytes.
+template <typename Codec>
+class StreamEncoder
+{
+public:
+    size_t update(const char * src, size_t size, char * out)
+    {
+        size_t written = 0;
+        if (carry_size != 0)
+        {
+            while (carry_size < 3 && size != 0)
+            {
+                carry[carry_size++] = *src++;
+                --size;
+            }
+            if (carry_size < 3)
+                return 0;
+            written += Codec::encode(carry, 3, out);
+            carry_size = 0;
+        }
+
+        const auto aligned = size / 3 * 3;
+        if (aligned != 0)
+            written += Codec::encode(src, aligned, out + written);
+
+        carry_size = size - aligned;
+        std::memcpy(carry, src + aligned, carry_size);
+        return written;
+    }
+
+    size_t finish(char * out)
+    {
+        const auto written = carry_size == 0 ? 0 : Codec::encode(carry, carry_size, out);
+        carry_size = 0;
+        return written;
+    }
+
+private:
+    char carry[3];
+    size_t carry_size = 0;
+};
+
+/// Streaming decoder for codecs that only have a one-shot API: the input is split at a multiple of 4 symbols,
+/// up to 3 trailing symbols are carried over to the next call.
+/// `update` needs room for `base64DecodedSizeUpperBound(size + 3)` bytes in `out`.
+/// Both `update` and `finish` return false if the input is not valid base64.
+template <typename Codec>
+class StreamDecoder
+{
+public:
+    bool update(const char * src, size_t size, char * out, size_t & outlen)
+    {
+        outlen = 0;
+        if (carry_size != 0)
+        {
+            while (carry_size < 4 && size != 0)
+            {
+                carry[carry_size++] = *src++;
+                --size;
+            }
+            if (carry_size < 4)
+                return true;
+            if (!decodeAligned(carry, 4, out, outlen))
+                return false;
+            carry_size = 0;
+        }
+
+        const auto aligned = size / 4 * 4;
+        if (!decodeAligned(src, aligned, out, outlen))
+            return false;
+
+        carry_size = size - aligned;
+        std::memcpy(carry, src + aligned, carry_size);
+        return true;
+    }
+
+    /// Input that is not a multiple of 4 symbols is not valid (padding is required).
+    bool finish() const { return carry_size == 0; }
+
+private:
+    static bool decodeAligned(const char * src, size_t size, char * out, size_t & outlen)
+    {
+        if (size == 0)
+            return true;
+        const auto written = Codec::decode(src, size, out + outlen);
+        if (written == 0)
+            return false;
+        outlen += written;
+        return true;
+    }
+
+    char carry[4];
+    size_t carry_size = 0;
+};
+
+/// aklomp/base64 has a streaming API of its own that keeps the carry in `base64_state`.
+template <>
+class StreamEncoder<AklompBase64>
+{
+public:
+    StreamEncoder() { base64_stream_encode_init(&state, 0); }
+
+    size_t update(const char * src, size_t size, char * out)
+    {
+        size_t outlen = 0;
+        base64_stream_encode(&state, src, size, out, &outlen);
+        return outlen;
+    }
+
+    size_t finish(char * out)
+    {
+        size_t outlen = 0;
+        base64_stream_encode_final(&state, out, &outlen);
+        return outlen;
+    }
+
+private:
+    base64_state state;
+};
+
+template <>
+class StreamDecoder<AklompBase64>
+{
+public:
+    StreamDecoder() { base64_stream_decode_init(&state, 0); }
+
+    bool update(const char * src, size_t size, char * out, size_t & outlen)
+    {
+        outlen = 0;
+        return base64_stream_decode(&state, src, size, out, &outlen) == 1;
+    }
+
+    /// The state keeps the number of symbols of an unfinished quadruple.
+    bool finish() const { return state.bytes == 0; }
+
+private:
+    base64_state state;
+};
+
+/// Writes the whole buffer, retrying on short writes. Returns false on an I/O error.
+inline bool writeAll(int fd, const char * data, size_t size)
+{
+    while (size != 0)
+    {
+        const auto res = ::write(fd, data, size);
+        if (res < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data += res;
+        size -= static_cast<size_t>(res);
+    }
+    return true;
+}
+
+/// Reads up to `size` bytes, retrying on EINTR. Returns -1 on an I/O error and 0 at the end of file.
+inline ssize_t readSome(int fd, char * data, size_t size)
+{
+    while (true)
+    {
+        const auto res = ::read(fd, data, size);
+        if (res >= 0 || errno != EINTR)
+            return res;
+    }
+}
+
+/// Reads the whole `in_fd` in chunks of `chunk_size`, encodes them and writes the result to `out_fd`.
+/// Returns false on an I/O error.
+template <typename Codec>
+bool streamEncode(int in_fd, int out_fd, size_t chunk_size)
+{
+    std::vector<char> input(chunk_size);
+    std::vector<char> output(base64EncodedSize(chunk_size + 2));
+    StreamEncoder<Codec> encoder;
+
+    while (true)
+    {
+        const auto res = readSome(in_fd, input.data(), chunk_size);
+        if (res < 0)
+            return false;
+        if (res == 0)
+            break;
+        const auto outlen = encoder.update(input.data(), static_cast<size_t>(res), output.data());
+        if (!writeAll(out_fd, output.data(), outlen))
+            return false;
+    }
+    return writeAll(out_fd, output.data(), encoder.finish(output.data()));
+}
+
+/// Reads the whole `in_fd` in chunks of `chunk_size`, decodes them and writes the result to `out_fd`.
+/// Returns false on an I/O error or invalid input.
+template <typename Codec>
+bool streamDecode(int in_fd, int out_fd, size_t chunk_size)
+{
+    std::vector<char> input(chunk_size);
+    std::vector<char> output(base64DecodedSizeUpperBound(chunk_size + 3));
+    StreamDecoder<Codec> decoder;
+
+    while (true)
+    {
+        const auto res = readSome(in_fd, input.data(), chunk_size);
+        if (res < 0)
+            return false;
+        if (res == 0)
+            break;
+        size_t outlen = 0;
+        if (!decoder.update(input.data(), static_cast<size_t>(res), output.data(), outlen))
+            return false;
+        if (!writeAll(out_fd, output.data(), outlen))
+            return false;
+    }
+    return decoder.finish();
+}
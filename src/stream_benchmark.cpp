@@ -0,0 +1,99 @@
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "codecs.h"
+#include "initializer.h"
+#include "memory_usage.h"
+#include "perf_counters.h"
+#include "stream.h"
+#include "temporary_file.h"
+
+/// Stream benchmarks go file to file through a fixed-size buffer, the argument is the chunk size.
+/// Besides the throughput they report the peak resident set size of the process during the run
+/// and how much it grew compared to the start of the run.
+static constexpr size_t streamInputSize = 128 << 20;
+
+static std::string makeStreamInput()
+{
+    std::string data;
+    data.reserve(streamInputSize);
+    for (size_t i = 0; data.size() < streamInputSize; ++i)
+        data.append(Initializer::stringsToEncode[i % Initializer::stringsToEncode.size()]);
+    data.resize(streamInputSize);
+    return data;
+}
+
+static std::string encodeStreamInput(const std::string & data)
+{
+    std::string encoded(base64EncodedSize(data.size()), '\0');
+    AklompBase64::encode(data.data(), data.size(), encoded.data());
+    return encoded;
+}
+
+/// The input files are created once and removed at exit.
+static TemporaryFile & streamInputFile()
+{
+    static TemporaryFile file("stream-input", makeStreamInput());
+    return file;
+}
+
+static TemporaryFile & streamEncodedInputFile()
+{
+    static TemporaryFile file("stream-encoded-input", encodeStreamInput(streamInputFile().read()));
+    return file;
+}
+
+template <typename Function>
+static void runStream(benchmark::State & state, TemporaryFile & input, TemporaryFile & expected, Function && function)
+{
+    TemporaryFile output("stream-output");
+    const auto chunk_size = static_cast<size_t>(state.range(0));
+
+    input.rewind();
+    if (!function(input.fd(), output.fd(), chunk_size) || output.read() != expected.read())
+    {
+        state.SkipWithError("Streaming output differs from the one-shot one");
+        return;
+    }
+
+    const auto memory_usage_before = currentMemoryUsage();
+    resetPeakMemoryUsage();
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        input.rewind();
+        output.truncate();
+        if (!function(input.fd(), output.fd(), chunk_size))
+        {
+            state.SkipWithError("I/O error");
+            return;
+        }
+    }
+    const auto peak_memory_usage = peakMemoryUsage();
+
+    state.counters["peak_rss"] = benchmark::Counter(static_cast<double>(peak_memory_usage), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+    state.counters["rss_growth"] = benchmark::Counter(
+        static_cast<double>(peak_memory_usage > memory_usage_before ? peak_memory_usage - memory_usage_before : 0),
+        benchmark::Counter::kDefaults,
+        benchmark::Counter::kIs1024);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(streamInputSize));
+    perf_counters.report(state);
+}
+
+template <typename Codec>
+static void BM_StreamEncode(benchmark::State & state)
+{
+    runStream(state, streamInputFile(), streamEncodedInputFile(), streamEncode<Codec>);
+}
+
+template <typename Codec>
+static void BM_StreamDecode(benchmark::State & state)
+{
+    runStream(state, streamEncodedInputFile(), streamInputFile(), streamDecode<Codec>);
+}
+
+BENCHMARK_TEMPLATE(BM_StreamEncode, TurboBase64)->RangeMultiplier(4)->Range(4 << 10, 64 << 20)->UseRealTime()->Unit(benchmark::kMillisecond)->Name("Turbo-Base64 stream encode 128MiB");
+BENCHMARK_TEMPLATE(BM_StreamEncode, AklompBase64)->RangeMultiplier(4)->Range(4 << 10, 64 << 20)->UseRealTime()->Unit(benchmark::kMillisecond)->Name("aklomp/base64 stream encode 128MiB");
+BENCHMARK_TEMPLATE(BM_StreamDecode, TurboBase64)->RangeMultiplier(4)->Range(4 << 10, 64 << 20)->UseRealTime()->Unit(benchmark::kMillisecond)->Name("Turbo-Base64 stream decode 128MiB");
+BENCHMARK_TEMPLATE(BM_StreamDecode, AklompBase64)->RangeMultiplier(4)->Range(4 << 10, 64 << 20)->UseRealTime()->Unit(benchmark::kMillisecond)->Name("aklomp/base64 stream decode 128MiB");
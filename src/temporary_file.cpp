@@ -0,0 +1,66 @@
+#include "temporary_file.h"
+
+#include <fcntl.h>
+#include <filesystem>
+#include <stdexcept>
+#include <unistd.h>
+
+TemporaryFile::TemporaryFile(std::string_view name)
+    : file_path(std::filesystem::temp_directory_path() / ("base64-benchmark-" + std::to_string(::getpid()) + "-" + std::string(name)))
+{
+    descriptor = ::open(file_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (descriptor < 0)
+        throw std::runtime_error("Cannot create temporary file " + file_path);
+}
+
+TemporaryFile::TemporaryFile(std::string_view name, std::string_view data)
+    : TemporaryFile(name)
+{
+    write(data);
+}
+
+TemporaryFile::~TemporaryFile()
+{
+    ::close(descriptor);
+    ::unlink(file_path.c_str());
+}
+
+void TemporaryFile::truncate()
+{
+    if (::ftruncate(descriptor, 0) != 0)
+        throw std::runtime_error("Cannot truncate temporary file " + file_path);
+    rewind();
+}
+
+void TemporaryFile::rewind()
+{
+    if (::lseek(descriptor, 0, SEEK_SET) != 0)
+        throw std::runtime_error("Cannot seek in temporary file " + file_path);
+}
+
+void TemporaryFile::write(std::string_view data)
+{
+    truncate();
+    while (!data.empty())
+    {
+        const auto res = ::write(descriptor, data.data(), data.size());
+        if (res < 0)
+            throw std::runtime_error("Cannot write to temporary file " + file_path);
+        data.remove_prefix(static_cast<size_t>(res));
+    }
+    rewind();
+}
+
+std::string TemporaryFile::read() const
+{
+    std::string data(static_cast<size_t>(::lseek(descriptor, 0, SEEK_END)), '\0');
+    size_t offset = 0;
+    while (offset < data.size())
+    {
+        const auto res = ::pread(descriptor, data.data() + offset, data.size() - offset, static_cast<off_t>(offset));
+        if (res <= 0)
+            throw std::runtime_error("Cannot read temporary file " + file_path);
+        offset += static_cast<size_t>(res);
+    }
+    return data;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+/// A file in the temporary directory that is opened for reading and writing, and removed in the destructor.
+class TemporaryFile
+{
+public:
+    explicit TemporaryFile(std::string_view name);
+    TemporaryFile(std::string_view name, std::string_view data);
+    ~TemporaryFile();
+
+    TemporaryFile(const TemporaryFile &) = delete;
+    TemporaryFile & operator=(const TemporaryFile &) = delete;
+
+    int fd() const { return descriptor; }
+    const std::string & path() const { return file_path; }
+
+    /// Truncates the file and moves the offset to the beginning.
+    void truncate();
+
+    /// Moves the offset to the beginning.
+    void rewind();
+
+    /// Replaces the contents of the file with `data`.
+    void write(std::string_view data);
+
+    /// Reads the whole file.
+    std::string read() const;
+
+private:
+    std::string file_path;
+    int descriptor = -1;
+};
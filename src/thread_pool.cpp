@@ -0,0 +1,102 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(size_t threads)
+{
+    if (threads == 0)
+        threads = 1;
+
+    queues.reserve(threads);
+    for (size_t i = 0; i < threads; ++i)
+        queues.push_back(std::make_unique<Queue>());
+
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i)
+        workers.emplace_back([this, i] { workerLoop(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(mutex);
+        shutdown = true;
+    }
+    has_work.notify_all();
+    for (auto & worker : workers)
+        worker.join();
+}
+
+void ThreadPool::parallelFor(size_t tasks, const std::function<void(size_t)> & task)
+{
+    if (tasks == 0)
+        return;
+
+    remaining = tasks;
+
+    const auto threads = queues.size();
+    for (size_t i = 0; i < threads; ++i)
+    {
+        const auto begin = tasks * i / threads;
+        const auto end = tasks * (i + 1) / threads;
+        std::lock_guard lock(queues[i]->mutex);
+        for (size_t index = begin; index < end; ++index)
+            queues[i]->tasks.push_back({&task, index});
+    }
+
+    std::unique_lock lock(mutex);
+    ++generation;
+    has_work.notify_all();
+    all_done.wait(lock, [this] { return remaining == 0; });
+}
+
+bool ThreadPool::popOwn(size_t worker, Task & task)
+{
+    auto & queue = *queues[worker];
+    std::lock_guard lock(queue.mutex);
+    if (queue.tasks.empty())
+        return false;
+    task = queue.tasks.front();
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool ThreadPool::steal(size_t worker, Task & task)
+{
+    const auto threads = queues.size();
+    for (size_t i = 1; i < threads; ++i)
+    {
+        auto & queue = *queues[(worker + i) % threads];
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t worker)
+{
+    size_t seen_generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock(mutex);
+            has_work.wait(lock, [&] { return shutdown || generation != seen_generation; });
+            if (shutdown)
+                return;
+            seen_generation = generation;
+        }
+
+        Task task;
+        while (popOwn(worker, task) || steal(worker, task))
+        {
+            (*task.function)(task.index);
+            if (remaining.fetch_sub(1) == 1)
+            {
+                std::lock_guard lock(mutex);
+                all_done.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// A fixed-size pool of threads with a work-stealing queue per thread.
+/// `parallelFor` splits the tasks into contiguous ranges, one per thread; a thread takes tasks
+/// from the front of its own queue and, once it is empty, steals from the back of the others.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool & operator=(const ThreadPool &) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    /// Runs `task(i)` for every `i` in [0, tasks) and waits until all of them are finished.
+    void parallelFor(size_t tasks, const std::function<void(size_t)> & task);
+
+private:
+    /// A task carries its function, so a worker that is late for one `parallelFor` call
+    /// cannot run the tasks of the next call with a stale function.
+    struct Task
+    {
+        const std::function<void(size_t)> * function;
+        size_t index;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(size_t worker);
+    bool popOwn(size_t worker, Task & task);
+    bool steal(size_t worker, Task & task);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable has_work;
+    std::condition_variable all_done;
+    size_t generation = 0;
+    std::atomic<size_t> remaining = 0;
+    bool shutdown = false;
+};
@@ -0,0 +1,16 @@
+#include "validation.h"
+
+size_t findInvalidBase64(const char * src, size_t size)
+{
+    size_t padding = 0;
+    if (size >= 4 && size % 4 == 0)
+        padding = (src[size - 1] == '=') + (src[size - 1] == '=' && src[size - 2] == '=');
+
+    const auto symbols = size - padding;
+    const auto offset = hasAvx512Vbmi() ? avx512vbmiFindInvalid(src, symbols) : scalarFindInvalid(src, symbols);
+    if (offset != symbols)
+        return offset;
+    if (size % 4 != 0)
+        return size;
+    return validBase64;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+#include "codecs.h"
+
+/// Decoding of untrusted input: the error is reported as the offset of the first byte that makes the input invalid.
+
+/// Returned by `findInvalidBase64` for valid input.
+static constexpr size_t validBase64 = std::numeric_limits<size_t>::max();
+
+/// Offset of the first byte that makes `src` invalid base64, `validBase64` if there is none.
+/// Up to two '=' are allowed at the end; input that is not a multiple of 4 symbols is reported at `size`.
+/// Uses the AVX-512 VBMI lookup when the CPU supports it, so garbage is rejected without decoding anything.
+size_t findInvalidBase64(const char * src, size_t size);
+
+/// Decodes with the codec at full speed and only looks for the error when the codec rejects the input,
+/// so valid input costs the same as a plain decode. Relies on the codec to validate.
+/// Returns the decoded size, or 0 with `error_offset` set on invalid input.
+template <typename Codec>
+size_t decodeReportingError(const char * src, size_t size, char * out, size_t & error_offset)
+{
+    error_offset = validBase64;
+    if (size == 0)
+        return 0;
+    const auto written = Codec::decode(src, size, out);
+    if (written == 0)
+        error_offset = findInvalidBase64(src, size);
+    return written;
+}
+
+/// Validates the whole input first and decodes only if it is valid,
+/// so invalid input is rejected before any decoding work, whether the codec validates or not.
+/// Returns the decoded size, or 0 with `error_offset` set on invalid input.
+template <typename Codec>
+size_t decodePrevalidated(const char * src, size_t size, char * out, size_t & error_offset)
+{
+    error_offset = findInvalidBase64(src, size);
+    if (error_offset != validBase64 || size == 0)
+        return 0;
+    return Codec::decode(src, size, out);
+}
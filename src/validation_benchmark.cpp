@@ -0,0 +1,118 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "codecs.h"
+#include "initializer.h"
+#include "perf_counters.h"
+#include "validation.h"
+
+/// Validating decode benchmarks: the ~50 symbols, ~200 symbols and the longest inputs,
+/// either valid or with one byte replaced by an invalid symbol at the start, in the middle or at the end.
+/// The reported error offset is checked against the position of the corruption.
+enum class Corruption : int64_t
+{
+    None,
+    Start,
+    Middle,
+    End,
+};
+
+static constexpr size_t noCorruption = validBase64;
+
+static std::string makeInput(benchmark::State & state, size_t & corrupted_offset)
+{
+    std::string input(Initializer::stringsToDecode[state.range(0)]);
+    switch (static_cast<Corruption>(state.range(1)))
+    {
+        case Corruption::None:
+            corrupted_offset = noCorruption;
+            break;
+        case Corruption::Start:
+            corrupted_offset = 0;
+            break;
+        case Corruption::Middle:
+            corrupted_offset = input.size() / 2;
+            break;
+        case Corruption::End:
+            corrupted_offset = input.size() - 1;
+            break;
+    }
+    if (corrupted_offset != noCorruption)
+        input[corrupted_offset] = '!';
+    state.counters["size"] = static_cast<double>(input.size());
+    return input;
+}
+
+template <typename Decode>
+static void runValidatingDecode(benchmark::State & state, Decode && decode)
+{
+    size_t corrupted_offset = noCorruption;
+    const auto input = makeInput(state, corrupted_offset);
+    std::string output;
+    output.resize(input.size());
+
+    size_t error_offset = validBase64;
+    decode(input, output, error_offset);
+    if (error_offset != corrupted_offset)
+    {
+        state.SkipWithError("The reported error offset does not match the corruption");
+        return;
+    }
+
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        benchmark::DoNotOptimize(decode(input, output, error_offset));
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+    perf_counters.report(state);
+}
+
+template <typename Codec>
+static void BM_DecodeReportingError(benchmark::State & state)
+{
+    runValidatingDecode(state, [](const std::string & input, std::string & output, size_t & error_offset)
+    {
+        return decodeReportingError<Codec>(input.data(), input.size(), output.data(), error_offset);
+    });
+}
+
+template <typename Codec>
+static void BM_DecodePrevalidated(benchmark::State & state)
+{
+    runValidatingDecode(state, [](const std::string & input, std::string & output, size_t & error_offset)
+    {
+        return decodePrevalidated<Codec>(input.data(), input.size(), output.data(), error_offset);
+    });
+}
+
+static void BM_FindInvalid(benchmark::State & state)
+{
+    if (!hasAvx512Vbmi())
+        state.SetLabel("scalar fallback");
+    runValidatingDecode(state, [](const std::string & input, std::string &, size_t & error_offset)
+    {
+        error_offset = findInvalidBase64(input.data(), input.size());
+        return error_offset;
+    });
+}
+
+static void validatingDecodeArguments(benchmark::internal::Benchmark * benchmark)
+{
+    std::vector<int64_t> corruptions;
+    for (const auto corruption : {Corruption::None, Corruption::Start, Corruption::Middle, Corruption::End})
+        corruptions.push_back(static_cast<int64_t>(corruption));
+    benchmark->ArgNames({"input", "corruption"})->ArgsProduct({{0, 6, 12}, corruptions});
+}
+
+BENCHMARK_TEMPLATE(BM_DecodeReportingError, TurboBase64)->Apply(validatingDecodeArguments)->Name("Turbo-Base64 decode reporting error");
+BENCHMARK_TEMPLATE(BM_DecodeReportingError, AklompBase64)->Apply(validatingDecodeArguments)->Name("aklomp/base64 decode reporting error");
+
+BENCHMARK_TEMPLATE(BM_DecodePrevalidated, TurboBase64)->Apply(validatingDecodeArguments)->Name("Turbo-Base64 decode prevalidated");
+BENCHMARK_TEMPLATE(BM_DecodePrevalidated, AklompBase64)->Apply(validatingDecodeArguments)->Name("aklomp/base64 decode prevalidated");
+
+BENCHMARK(BM_FindInvalid)->Apply(validatingDecodeArguments)->Name("validate only");
@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "codecs.h"
+#include "initializer.h"
+#include "mime.h"
+#include "perf_counters.h"
+
+/// base64url and MIME base64 at the size classes of main.cpp. The AVX-512 VBMI kernels do the alphabet swap
+/// and the line breaks in the same pass, the libraries are wrapped with a separate pass over their output.
+
+/// base64url from a standard codec: the alphabet is swapped and the padding dropped in a second pass.
+template <typename Codec>
+struct TranslatedBase64Url
+{
+    static size_t encode(const char * src, size_t srclen, char * out)
+    {
+        auto written = Codec::encode(src, srclen, out);
+        for (size_t i = 0; i < written; ++i)
+        {
+            if (out[i] == '+')
+                out[i] = '-';
+            else if (out[i] == '/')
+                out[i] = '_';
+        }
+        while (written != 0 && out[written - 1] == '=')
+            --written;
+        return written;
+    }
+
+    static size_t decode(const char * src, size_t srclen, char * out)
+    {
+        thread_local std::vector<char> buffer;
+        buffer.assign(src, src + srclen);
+        for (auto & symbol : buffer)
+        {
+            if (symbol == '-')
+                symbol = '+';
+            else if (symbol == '_')
+                symbol = '/';
+            else if (symbol == '+' || symbol == '/' || symbol == '=')
+                return 0;
+        }
+        while (buffer.size() % 4 != 0)
+            buffer.push_back('=');
+        return Codec::decode(buffer.data(), buffer.size(), out);
+    }
+};
+
+/// MIME base64 from a standard codec: encoded into a buffer and copied line by line, or decoded with the line breaks skipped.
+template <typename Codec>
+struct ReformattedBase64Mime
+{
+    static size_t encode(const char * src, size_t srclen, char * out)
+    {
+        thread_local std::vector<char> buffer;
+        buffer.resize(base64EncodedSize(srclen));
+        const auto symbols = Codec::encode(src, srclen, buffer.data());
+        size_t written = 0;
+        for (size_t i = 0; i < symbols; i += mimeLineSymbols)
+        {
+            if (i != 0)
+            {
+                out[written++] = '\r';
+                out[written++] = '\n';
+            }
+            const auto line = std::min(mimeLineSymbols, symbols - i);
+            std::memcpy(out + written, buffer.data() + i, line);
+            written += line;
+        }
+        return written;
+    }
+
+    static size_t decode(const char * src, size_t srclen, char * out)
+    {
+        size_t outlen = 0;
+        if (!decodeSkippingLineBreaks(src, srclen, out, outlen, Codec::decode))
+            return 0;
+        return outlen;
+    }
+};
+
+template <typename Variant>
+static void BM_VariantEncode(benchmark::State & state)
+{
+    const auto idx = state.range(0);
+    const auto input = Initializer::stringsToEncode[idx];
+    const auto size = input.size();
+    state.counters["size"] = static_cast<double>(size);
+    std::string output;
+    output.resize(mimeEncodedSize(size));
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        Variant::encode(input.data(), size, output.data());
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
+}
+
+template <typename Variant>
+constexpr bool isMimeVariant = false;
+
+template <>
+constexpr bool isMimeVariant<Avx512VbmiBase64Mime> = true;
+
+template <typename Codec>
+constexpr bool isMimeVariant<ReformattedBase64Mime<Codec>> = true;
+
+/// MIME decoders must skip line breaks of any layout, not only after every 76 symbols: here a line break goes before
+/// the first symbol and another one after the 74th, so that the first 76 bytes hold a line break and are followed by CRLF.
+template <typename Variant>
+static bool decodesIrregularLayout(std::string_view raw)
+{
+    std::string encoded(base64EncodedSize(raw.size()), '\0');
+    scalarEncode(raw.data(), raw.size(), encoded.data());
+    const auto split = std::min<size_t>(74, encoded.size());
+    const auto input = "\r\n" + encoded.substr(0, split) + "\r\n" + encoded.substr(split);
+    std::string output(input.size(), '\0');
+    const auto written = Variant::decode(input.data(), input.size(), output.data());
+    return written == raw.size() && std::string_view(output.data(), written) == raw;
+}
+
+template <typename Variant>
+static void BM_VariantDecode(benchmark::State & state)
+{
+    const auto idx = state.range(0);
+    const auto raw = Initializer::stringsToEncode[idx];
+    std::string input;
+    input.resize(mimeEncodedSize(raw.size()));
+    input.resize(Variant::encode(raw.data(), raw.size(), input.data()));
+    const auto size = input.size();
+    state.counters["size"] = static_cast<double>(size);
+    std::string output;
+    output.resize(size);
+    if (Variant::decode(input.data(), size, output.data()) != raw.size())
+    {
+        state.SkipWithError("Cannot decode the encoded input");
+        return;
+    }
+    if constexpr (isMimeVariant<Variant>)
+    {
+        if (!decodesIrregularLayout<Variant>(raw))
+        {
+            state.SkipWithError("Cannot decode the input with irregular line breaks");
+            return;
+        }
+    }
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        Variant::decode(input.data(), size, output.data());
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    perf_counters.report(state);
+}
+
+template <typename Variant>
+static void registerVariantBenchmarks(const std::string & name)
+{
+    for (const auto & size_class : Initializer::sizeClasses)
+    {
+        const auto encode_name = name + " encode " + size_class.name;
+        const auto decode_name = name + " decode " + size_class.name;
+        benchmark::RegisterBenchmark(encode_name.c_str(), BM_VariantEncode<Variant>)->DenseRange(size_class.first, size_class.last);
+        benchmark::RegisterBenchmark(decode_name.c_str(), BM_VariantDecode<Variant>)->DenseRange(size_class.first, size_class.last);
+    }
+}
+
+static bool registerAllVariantBenchmarks()
+{
+    registerVariantBenchmarks<Avx512VbmiBase64Url>(Avx512VbmiBase64Url::name);
+    registerVariantBenchmarks<TranslatedBase64Url<TurboBase64>>("Turbo-Base64 + translate base64url");
+    registerVariantBenchmarks<TranslatedBase64Url<AklompBase64>>("aklomp/base64 + translate base64url");
+
+    registerVariantBenchmarks<Avx512VbmiBase64Mime>(Avx512VbmiBase64Mime::name);
+    registerVariantBenchmarks<ReformattedBase64Mime<TurboBase64>>("Turbo-Base64 + reformat MIME");
+    registerVariantBenchmarks<ReformattedBase64Mime<AklompBase64>>("aklomp/base64 + reformat MIME");
+    return true;
+}
+
+[[maybe_unused]] static const bool variantBenchmarksRegistered = registerAllVariantBenchmarks();
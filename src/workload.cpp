@@ -0,0 +1,173 @@
+#include "workload.h"
+
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+std::string_view toString(LengthDistribution distribution)
+{
+    switch (distribution)
+    {
+        case LengthDistribution::Uniform:
+            return "uniform";
+        case LengthDistribution::Zipf:
+            return "zipf";
+        case LengthDistribution::Histogram:
+            return "histogram";
+    }
+    return "unknown";
+}
+
+std::string_view toString(ContentClass content)
+{
+    switch (content)
+    {
+        case ContentClass::Url:
+            return "url";
+        case ContentClass::Cyrillic:
+            return "cyrillic";
+        case ContentClass::Binary:
+            return "binary";
+    }
+    return "unknown";
+}
+
+LengthGenerator::LengthGenerator(std::vector<size_t> lengths_, const std::vector<double> & weights)
+    : lengths(std::move(lengths_))
+    , distribution(weights.begin(), weights.end())
+{
+}
+
+LengthGenerator LengthGenerator::uniform(size_t min_length, size_t max_length)
+{
+    std::vector<size_t> lengths;
+    for (size_t length = min_length; length <= max_length; ++length)
+        lengths.push_back(length);
+    return LengthGenerator(std::move(lengths), std::vector<double>(max_length - min_length + 1, 1.0));
+}
+
+LengthGenerator LengthGenerator::zipf(size_t min_length, size_t max_length, double exponent)
+{
+    std::vector<size_t> lengths;
+    std::vector<double> weights;
+    for (size_t length = min_length; length <= max_length; ++length)
+    {
+        lengths.push_back(length);
+        weights.push_back(1.0 / std::pow(static_cast<double>(length - min_length + 1), exponent));
+    }
+    return LengthGenerator(std::move(lengths), weights);
+}
+
+LengthGenerator LengthGenerator::histogram(const std::string & path)
+{
+    std::ifstream file(path);
+    if (!file)
+        throw std::runtime_error("Cannot open length histogram " + path);
+
+    std::vector<size_t> lengths;
+    std::vector<double> weights;
+    std::string line;
+    for (size_t line_number = 1; std::getline(file, line); ++line_number)
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::istringstream fields(line);
+        int64_t length = 0;
+        double count = 0;
+        std::string junk;
+        if (!(fields >> length >> count) || fields >> junk || length < 0 || length > maxHistogramLength || count < 0)
+            throw std::runtime_error("Cannot parse line " + std::to_string(line_number) + " of length histogram " + path);
+        lengths.push_back(static_cast<size_t>(length));
+        weights.push_back(count);
+    }
+    if (lengths.empty() || std::accumulate(weights.begin(), weights.end(), 0.0) == 0)
+        throw std::runtime_error("Length histogram " + path + " is empty");
+    return LengthGenerator(std::move(lengths), weights);
+}
+
+double LengthGenerator::mean() const
+{
+    const auto probabilities = distribution.probabilities();
+    double result = 0;
+    for (size_t i = 0; i < lengths.size(); ++i)
+        result += probabilities[i] * static_cast<double>(lengths[i]);
+    return result;
+}
+
+namespace
+{
+
+void appendUrl(std::string & row, size_t length, std::mt19937_64 & rng)
+{
+    static constexpr std::string_view prefixes[] = {
+        "https://www.example.com/",
+        "http://news.example.org/",
+        "https://shop.example.net/catalog/",
+        "https://m.example.ru/",
+    };
+    static constexpr std::string_view path_chars = "abcdefghijklmnopqrstuvwxyz0123456789-_/.?=&%";
+
+    const auto prefix = prefixes[rng() % std::size(prefixes)];
+    row.append(prefix.substr(0, length));
+    while (row.size() < length)
+        row.push_back(path_chars[rng() % path_chars.size()]);
+}
+
+void appendCyrillic(std::string & row, size_t length, std::mt19937_64 & rng)
+{
+    size_t word_left = 3 + rng() % 8;
+    while (row.size() + 2 <= length)
+    {
+        if (word_left == 0 && row.size() + 3 <= length)
+        {
+            row.push_back(' ');
+            word_left = 3 + rng() % 8;
+        }
+        // U+0430..U+044F, lowercase letters from 'а' to 'я'.
+        const auto letter = 0x430 + rng() % 32;
+        row.push_back(static_cast<char>(0xC0 | (letter >> 6)));
+        row.push_back(static_cast<char>(0x80 | (letter & 0x3F)));
+        if (word_left != 0)
+            --word_left;
+    }
+    // A letter does not fit, finish with a punctuation mark.
+    if (row.size() < length)
+        row.push_back('.');
+}
+
+void appendBinary(std::string & row, size_t length, std::mt19937_64 & rng)
+{
+    while (row.size() < length)
+        row.push_back(static_cast<char>(rng()));
+}
+
+}
+
+ColumnString generateWorkload(LengthGenerator & lengths, ContentClass content, size_t rows, uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    ColumnString column;
+    column.offsets.reserve(rows);
+    std::string row;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        const auto length = lengths(rng);
+        row.clear();
+        switch (content)
+        {
+            case ContentClass::Url:
+                appendUrl(row, length, rng);
+                break;
+            case ContentClass::Cyrillic:
+                appendCyrillic(row, length, rng);
+                break;
+            case ContentClass::Binary:
+                appendBinary(row, length, rng);
+                break;
+        }
+        column.insert(row);
+    }
+    return column;
+}
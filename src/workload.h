@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "column.h"
+
+/// Generated inputs whose lengths vary from row to row the way they do in production,
+/// unlike the fixed strings of `Initializer`, whose lengths the branch predictor learns after a few iterations.
+
+/// How the lengths of the rows are drawn.
+enum class LengthDistribution
+{
+    Uniform,
+    Zipf,
+    /// An empirical histogram loaded from a file, see `LengthGenerator::histogram`.
+    Histogram,
+};
+
+/// What the rows contain.
+enum class ContentClass
+{
+    /// ASCII URLs: a scheme and a host followed by a path with a query string.
+    Url,
+    /// UTF-8 Cyrillic words separated by spaces, 2 bytes per letter.
+    Cyrillic,
+    /// Uniformly random bytes.
+    Binary,
+};
+
+std::string_view toString(LengthDistribution distribution);
+std::string_view toString(ContentClass content);
+
+/// Draws row lengths (in bytes) from a discrete distribution.
+class LengthGenerator
+{
+public:
+    /// Every length in [min_length, max_length] with the same probability.
+    static LengthGenerator uniform(size_t min_length, size_t max_length);
+
+    /// Length `min_length + k` with a probability proportional to 1 / (k + 1)^exponent, up to `max_length`.
+    static LengthGenerator zipf(size_t min_length, size_t max_length, double exponent);
+
+    /// Loads a histogram from a text file with a `length count` pair per line, empty lines and lines
+    /// starting with '#' are skipped. Lengths are at most `maxHistogramLength`, counts are not negative.
+    /// Throws std::runtime_error if the file cannot be read or parsed.
+    static LengthGenerator histogram(const std::string & path);
+
+    /// Far longer than any string value in ClickBench, and small enough for a block of generated rows to fit in memory.
+    static constexpr int64_t maxHistogramLength = 1 << 20;
+
+    size_t operator()(std::mt19937_64 & rng) { return lengths[distribution(rng)]; }
+
+    double mean() const;
+
+private:
+    LengthGenerator(std::vector<size_t> lengths_, const std::vector<double> & weights);
+
+    std::vector<size_t> lengths;
+    std::discrete_distribution<size_t> distribution;
+};
+
+/// Generates `rows` independent rows with lengths from `lengths` and the given content,
+/// so consecutive rows have unrelated lengths. The same seed gives the same column.
+ColumnString generateWorkload(LengthGenerator & lengths, ContentClass content, size_t rows, uint64_t seed);
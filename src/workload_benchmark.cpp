@@ -0,0 +1,135 @@
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "codecs.h"
+#include "column.h"
+#include "perf_counters.h"
+#include "workload.h"
+
+/// Workload benchmarks encode and decode a column of generated rows whose lengths vary from row to row,
+/// which exposes the branch mispredictions and tail handling costs that the fixed inputs of main.cpp hide.
+/// The histogram benchmarks are only registered when BASE64_BENCHMARK_LENGTH_HISTOGRAM names a histogram file.
+static constexpr size_t workloadRows = 1 << 16;
+static constexpr uint64_t workloadSeed = 42;
+static constexpr const char * histogramVariable = "BASE64_BENCHMARK_LENGTH_HISTOGRAM";
+
+struct Workload
+{
+    LengthDistribution distribution;
+    ContentClass content;
+};
+
+static LengthGenerator makeLengthGenerator(LengthDistribution distribution)
+{
+    switch (distribution)
+    {
+        case LengthDistribution::Uniform:
+            return LengthGenerator::uniform(0, 256);
+        case LengthDistribution::Zipf:
+            return LengthGenerator::zipf(8, 2048, 1.2);
+        case LengthDistribution::Histogram:
+            return LengthGenerator::histogram(std::getenv(histogramVariable));
+    }
+    throw std::logic_error("Unknown length distribution");
+}
+
+/// Generates the workload, or skips the benchmark if the histogram cannot be loaded.
+static std::optional<ColumnString> makeWorkload(benchmark::State & state, const Workload & workload)
+{
+    try
+    {
+        auto lengths = makeLengthGenerator(workload.distribution);
+        state.counters["mean_length"] = lengths.mean();
+        return generateWorkload(lengths, workload.content, workloadRows, workloadSeed);
+    }
+    catch (const std::exception & e)
+    {
+        state.SkipWithError(e.what());
+        return std::nullopt;
+    }
+}
+
+static void setWorkloadCounters(benchmark::State & state, const ColumnString & input)
+{
+    const auto rows = static_cast<double>(input.size());
+    state.counters["rows_per_second"] = benchmark::Counter(rows * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.offsets.back()));
+}
+
+template <typename Codec>
+static void BM_EncodeWorkload(benchmark::State & state, Workload workload)
+{
+    const auto input = makeWorkload(state, workload);
+    if (!input)
+        return;
+    ColumnString output;
+    encodeColumn<Codec>(*input, output);
+    const auto rows = input->size();
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        encodeColumnRows<Codec>(*input, output, 0, rows);
+        benchmark::DoNotOptimize(output.chars.data());
+        benchmark::ClobberMemory();
+    }
+    setWorkloadCounters(state, *input);
+    perf_counters.report(state);
+}
+
+template <typename Codec>
+static void BM_DecodeWorkload(benchmark::State & state, Workload workload)
+{
+    const auto raw = makeWorkload(state, workload);
+    if (!raw)
+        return;
+    ColumnString input;
+    encodeColumn<Codec>(*raw, input);
+    ColumnString output;
+    if (!decodeColumn<Codec>(input, output))
+    {
+        state.SkipWithError("Invalid base64 in the input column");
+        return;
+    }
+    PerfCounters perf_counters;
+    for ([[maybe_unused]] auto iteration : state)
+    {
+        decodeColumn<Codec>(input, output);
+        benchmark::DoNotOptimize(output.chars.data());
+        benchmark::ClobberMemory();
+    }
+    setWorkloadCounters(state, input);
+    perf_counters.report(state);
+}
+
+template <typename Codec>
+static void registerWorkloadBenchmarks(const Workload & workload)
+{
+    const auto suffix = std::string(toString(workload.distribution)) + " " + std::string(toString(workload.content));
+    const auto encode_name = std::string(Codec::name) + " encode workload " + suffix;
+    const auto decode_name = std::string(Codec::name) + " decode workload " + suffix;
+    benchmark::RegisterBenchmark(encode_name.c_str(), BM_EncodeWorkload<Codec>, workload)->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark(decode_name.c_str(), BM_DecodeWorkload<Codec>, workload)->Unit(benchmark::kMicrosecond);
+}
+
+static bool registerAllWorkloadBenchmarks()
+{
+    std::vector<LengthDistribution> distributions = {LengthDistribution::Uniform, LengthDistribution::Zipf};
+    if (std::getenv(histogramVariable) != nullptr)
+        distributions.push_back(LengthDistribution::Histogram);
+
+    for (const auto distribution : distributions)
+    {
+        for (const auto content : {ContentClass::Url, ContentClass::Cyrillic, ContentClass::Binary})
+        {
+            registerWorkloadBenchmarks<TurboBase64>({distribution, content});
+            registerWorkloadBenchmarks<AklompBase64>({distribution, content});
+        }
+    }
+    return true;
+}
+
+[[maybe_unused]] static const bool workloadBenchmarksRegistered = registerAllWorkloadBenchmarks();